@@ -0,0 +1,92 @@
+/*
+  borrowbench.cpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+
+  Compare the copying getters with the borrowing ones. We count every
+  allocation made so you can see the borrowed path doesn't make any.
+
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+
+  https://github.com/visualopsholdings/dict
+*/
+
+#include "dict.hpp"
+
+#include <iostream>
+#include <chrono>
+#include <new>
+#include <cstdlib>
+
+using namespace std;
+using namespace vops;
+
+static size_t allocs = 0;
+
+void *operator new(size_t size) {
+  allocs++;
+  void *p = malloc(size);
+  if (!p) {
+    throw bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void *p) noexcept {
+  free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+  free(p);
+}
+
+DictG makeDoc() {
+
+  // a config like thing with a reasonable amount of siblings at each level.
+  DictO root;
+  for (int i=0; i<20; i++) {
+    DictO section;
+    for (int j=0; j<20; j++) {
+      section["key" + to_string(j)] = "a value that is long enough not to be inline " + to_string(j);
+    }
+    root["section" + to_string(i)] = section;
+  }
+  return root;
+
+}
+
+template<typename F>
+void run(const string &name, int n, F f) {
+
+  size_t before = allocs;
+  auto start = chrono::steady_clock::now();
+  size_t total = 0;
+  for (int i=0; i<n; i++) {
+    total += f();
+  }
+  auto end = chrono::steady_clock::now();
+
+  cout << name << ": " << chrono::duration_cast<chrono::microseconds>(end - start).count() << "us, "
+    << (allocs - before) << " allocations (" << total << ")" << endl;
+
+}
+
+int main() {
+
+  DictG doc = makeDoc();
+  const int n = 10000;
+
+  run("copying ", n, [&doc]() {
+    auto s = Dict::getString(Dict::getObject(Dict::getObject(doc), "section10"), "key10");
+    return s ? s->size() : 0;
+  });
+
+  run("borrowed", n, [&doc]() {
+    auto s = Dict::getStringView(Dict::getObjectPtr(Dict::getObjectPtr(doc), "section10"), "key10");
+    return s ? s->size() : 0;
+  });
+
+  return 0;
+
+}
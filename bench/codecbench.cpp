@@ -0,0 +1,88 @@
+/*
+  codecbench.cpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+
+  The same document written and parsed as pretty and compact JSON, and as each
+  of the binary formats we were built with. And parsed again without saying what
+  it is.
+
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+
+  https://github.com/visualopsholdings/dict
+*/
+
+#include "dict.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+#include <boost/log/trivial.hpp>
+#include <boost/log/expressions.hpp>
+
+using namespace std;
+using namespace vops;
+
+template<typename F>
+double best(F f) {
+
+  double best = 1e9;
+  for (int i=0; i<3; i++) {
+    auto start = chrono::steady_clock::now();
+    f();
+    auto end = chrono::steady_clock::now();
+    best = min(best, chrono::duration<double, milli>(end - start).count());
+  }
+  return best;
+
+}
+
+int main() {
+
+  boost::log::core::get()->set_filter(boost::log::trivial::severity >= boost::log::trivial::warning);
+
+  DictV v;
+  for (int i=0; i<100000; i++) {
+    v.push_back(dictO({
+      { "id", "667d0baedfb1ed18430d" + to_string(i) },
+      { "name", "item " + to_string(i) },
+      { "value", i },
+      { "price", i * 0.25 },
+      { "active", i % 2 == 0 },
+      { "tags", DictV{ "a", "b", "c" } }
+    }));
+  }
+  // BSON has to be an object.
+  DictG g = dictO({ { "records", v } });
+
+  vector<pair<string, bool>> formats = {
+    { ".json", true }, { ".json", false }, { ".bson", false }, { ".msgpack", false }, { ".cbor", false }
+  };
+  for (auto &f: formats) {
+    auto name = f.first + (f.first == ".json" ? (f.second ? " pretty" : " compact") : "");
+    if (!Dict::hasFormat(f.first)) {
+      cout << left << setw(14) << name << "not built" << endl;
+      continue;
+    }
+    string s;
+    auto write = best([&]() { s = Dict::toString(g, f.second, f.first); });
+    auto read = best([&]() { Dict::parseString(s, f.first); });
+    auto sniffed = best([&]() { Dict::parseString(s, ""); });
+    cout << left << setw(14) << name
+      << setw(12) << (to_string(s.size()) + " bytes")
+      << " write " << write << "ms, parse " << read << "ms ("
+      << (s.size() / read / 1e3) << " MB/s), worked out " << sniffed << "ms" << endl;
+  }
+
+  // and the compact JSON with our own parser.
+  auto json = Dict::toString(g, false);
+  auto simd = best([&]() { Dict::parseSimd(json); });
+  cout << left << setw(14) << ".json simd"
+    << setw(12) << (to_string(json.size()) + " bytes")
+    << " parse " << simd << "ms (" << (json.size() / simd / 1e3) << " MB/s)" << endl;
+
+  return 0;
+
+}
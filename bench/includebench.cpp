@@ -0,0 +1,152 @@
+/*
+  includebench.cpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+
+  A config tree where the same fragments are included over and over, loading
+  the includes one at a time and in parallel, and then reloading it after changing
+  one of them.
+  
+  Then a wide tree of lots of big files that are only included once, which is
+  where loading them in parallel should pay off. It goes up to the number of 
+  cores or the number of threads given.
+
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+
+  https://github.com/visualopsholdings/dict
+*/
+
+#include "dict.hpp"
+#include "dictincludes.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <filesystem>
+#include <thread>
+#include <cstdlib>
+
+#include <boost/log/trivial.hpp>
+#include <boost/log/expressions.hpp>
+
+using namespace std;
+using namespace vops;
+namespace fs = std::filesystem;
+
+// a common fragment with lots of keys, some parts that all include it, and a root
+// that includes each part lots of times.
+fs::path makeTree(int keys, int parts, int copies) {
+
+  auto dir = fs::temp_directory_path() / "includebench";
+  fs::create_directories(dir);
+  {
+    ofstream f(dir / "common.json");
+    f << "{";
+    for (int i=0; i<keys; i++) {
+      f << (i > 0 ? "," : "") << "\"key" << i << "\":{\"value\":" << i << ",\"name\":\"common " << i << "\"}";
+    }
+    f << "}";
+  }
+  for (int i=0; i<parts; i++) {
+    ofstream f(dir / ("part" + to_string(i) + ".json"));
+    f << "{\"...\":\"<common.json>\",\"part\":" << i << "}";
+  }
+  {
+    ofstream f(dir / "root.json");
+    f << "{\"parts\":[";
+    for (int i=0; i<parts * copies; i++) {
+      f << (i > 0 ? "," : "") << "{\"...\":\"<part" << (i % parts) << ".json>\",\"copy\":" << i << "}";
+    }
+    f << "]}";
+  }
+  return dir;
+  
+}
+
+// a root that includes lots of different files, each with lots of keys.
+fs::path makeWide(int keys, int files) {
+
+  auto dir = fs::temp_directory_path() / "includebench-wide";
+  fs::create_directories(dir);
+  for (int i=0; i<files; i++) {
+    ofstream f(dir / ("file" + to_string(i) + ".json"));
+    f << "{";
+    for (int j=0; j<keys; j++) {
+      f << (j > 0 ? "," : "") << "\"key" << j << "\":{\"value\":" << j << ",\"name\":\"file " << i << " key " << j << "\",\"tags\":[\"a\",\"b\",\"c\"]}";
+    }
+    f << "}";
+  }
+  {
+    ofstream f(dir / "root.json");
+    f << "{\"files\":[";
+    for (int i=0; i<files; i++) {
+      f << (i > 0 ? "," : "") << "{\"...\":\"<file" << i << ".json>\"}";
+    }
+    f << "]}";
+  }
+  return dir;
+  
+}
+
+int main(int argc, char *argv[]) {
+
+  boost::log::core::get()->set_filter(boost::log::trivial::severity >= boost::log::trivial::warning);
+
+  int most = argc > 1 ? atoi(argv[1]) : max(1u, thread::hardware_concurrency());
+  cout << thread::hardware_concurrency() << " cores" << endl;
+
+  auto dir = makeTree(200, 100, 10);
+  
+  for (auto threads: { 1, 2, 4, 0 }) {
+    auto start = chrono::steady_clock::now();
+    auto g = Dict::parseFile((dir / "root.json").string(), false, threads);
+    auto end = chrono::steady_clock::now();
+    cout << "parseFile threads " << threads << ": " << chrono::duration_cast<chrono::milliseconds>(end - start).count() << "ms "
+      << (g ? "ok" : "failed") << endl;
+  }
+  
+  DictIncludes includes;
+  auto start = chrono::steady_clock::now();
+  auto g = Dict::parseFile((dir / "root.json").string(), includes);
+  auto end = chrono::steady_clock::now();
+  cout << "parseFile with includes: " << chrono::duration_cast<chrono::milliseconds>(end - start).count() << "ms "
+    << (g ? "ok" : "failed") << endl;
+  
+  {
+    ofstream f(dir / "part7.json");
+    f << "{\"...\":\"<common.json>\",\"part\":\"changed\"}";
+  }
+  fs::last_write_time(dir / "part7.json", fs::file_time_type::clock::now() + chrono::seconds(1));
+  start = chrono::steady_clock::now();
+  auto ok = (bool)includes.reload();
+  end = chrono::steady_clock::now();
+  cout << "reload one part: " << chrono::duration_cast<chrono::milliseconds>(end - start).count() << "ms "
+    << (ok ? "ok" : "failed") << endl;
+  
+  start = chrono::steady_clock::now();
+  ok = (bool)includes.reload();
+  end = chrono::steady_clock::now();
+  cout << "reload nothing: " << chrono::duration_cast<chrono::milliseconds>(end - start).count() << "ms "
+    << (ok ? "ok" : "failed") << endl;
+  
+  fs::remove_all(dir);
+  
+  auto wide = makeWide(5000, 64);
+  double first = 0;
+  for (int threads=1; threads<=most; threads*=2) {
+    start = chrono::steady_clock::now();
+    auto g = Dict::parseFile((wide / "root.json").string(), false, threads);
+    end = chrono::steady_clock::now();
+    double secs = chrono::duration<double>(end - start).count();
+    if (threads == 1) {
+      first = secs;
+    }
+    cout << "wide parseFile threads " << threads << ": " << (int)(secs * 1000) << "ms " << first / secs << "x "
+      << (g ? "ok" : "failed") << endl;
+  }
+  fs::remove_all(wide);
+  
+  return 0;
+
+}
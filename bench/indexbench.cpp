@@ -0,0 +1,73 @@
+/*
+  indexbench.cpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+
+  Compare scanning an object for a key with using a Dict::Index as the
+  object gets bigger, and looking for keys that aren't there.
+
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+
+  https://github.com/visualopsholdings/dict
+*/
+
+#include "dict.hpp"
+
+#include <iostream>
+#include <chrono>
+
+using namespace std;
+using namespace vops;
+
+template<typename F>
+long run(int n, F f) {
+
+  auto start = chrono::steady_clock::now();
+  size_t total = 0;
+  for (int i=0; i<n; i++) {
+    total += f(i);
+  }
+  auto end = chrono::steady_clock::now();
+  if (total != (size_t)n) {
+    cout << "found " << total << " of " << n << endl;
+  }
+
+  return chrono::duration_cast<chrono::nanoseconds>(end - start).count() / n;
+
+}
+
+int main() {
+
+  const int n = 100000;
+
+  cout << "keys\tscan ns\tindex ns\tmiss ns" << endl;
+  for (size_t size: { 8, 32, 128, 1024, 8192, 65536 }) {
+
+    DictO obj;
+    vector<string> keys;
+    for (size_t i=0; i<size; i++) {
+      keys.push_back("id" + to_string(i * 7919));
+      obj.insert(keys.back(), DictG((long)i));
+    }
+
+    auto scan = run(n, [&](int i) {
+      return Dict::getGenericPtr(&obj, keys[(i * 31) % size]) ? 1 : 0;
+    });
+
+    Dict::Index index(obj, 0);
+    auto indexed = run(n, [&](int i) {
+      return index.get(keys[(i * 31) % size]) ? 1 : 0;
+    });
+
+    // looking for ones that aren't there.
+    auto missed = run(n, [&](int i) {
+      return index.get("nope" + to_string(i % 1000)) ? 0 : 1;
+    });
+
+    cout << size << "\t" << scan << "\t" << indexed << "\t" << missed << endl;
+  }
+
+  return 0;
+
+}
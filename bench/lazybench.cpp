@@ -0,0 +1,85 @@
+/*
+  lazybench.cpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+
+  Read a few fields out of a big message, parsing all of it and then
+  parsing it lazily.
+
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+
+  https://github.com/visualopsholdings/dict
+*/
+
+#include "dictlazy.hpp"
+
+#include <iostream>
+#include <sstream>
+#include <chrono>
+
+#include <boost/log/trivial.hpp>
+#include <boost/log/expressions.hpp>
+
+using namespace std;
+using namespace vops;
+
+string makeMessage(int n) {
+
+  // a little header, and a lot of stuff nobody reads.
+  stringstream ss;
+  ss << "{\"type\":\"update\",\"user\":{\"id\":\"667d0baedfb1ed18430d8ed3\",\"name\":\"someone\"},\"items\":[";
+  for (int i=0; i<n; i++) {
+    if (i > 0) {
+      ss << ",";
+    }
+    ss << "{\"id\":\"667d0baedfb1ed18430d" << i << "\",\"name\":\"item " << i << "\",\"value\":" << i 
+      << ",\"active\":" << (i % 2 ? "true" : "false") << ",\"tags\":[\"a\",\"b\",\"c\"]}";
+  }
+  ss << "],\"seq\":42}";
+  return ss.str();
+
+}
+
+template<typename F>
+void run(const string &name, int n, F f) {
+
+  auto start = chrono::steady_clock::now();
+  size_t total = 0;
+  for (int i=0; i<n; i++) {
+    total += f();
+  }
+  auto end = chrono::steady_clock::now();
+
+  cout << name << ": " << chrono::duration_cast<chrono::microseconds>(end - start).count() / n << "us (" << total << ")" << endl;
+
+}
+
+int main() {
+
+  boost::log::core::get()->set_filter(boost::log::trivial::severity >= boost::log::trivial::warning);
+
+  auto msg = makeMessage(20000);
+  const int n = 20;
+  
+  cout << msg.size() << " bytes of JSON" << endl;
+
+  run("parse all  ", n, [&]() {
+    Dict d(Dict::parseString(msg));
+    return d.object("type").string().size() + d.object("user").object("id").string().size() + d.object("seq").num();
+  });
+
+  run("parse simd ", n, [&]() {
+    Dict d(Dict::parseSimd(msg));
+    return d.object("type").string().size() + d.object("user").object("id").string().size() + d.object("seq").num();
+  });
+
+  run("parse lazy ", n, [&]() {
+    auto lazy = Dict::parseLazy(msg);
+    auto root = lazy->root();
+    return root.object("type").string().size() + root.object("user").object("id").string().size() + root.object("seq").num();
+  });
+
+  return 0;
+
+}
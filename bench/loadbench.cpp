@@ -0,0 +1,114 @@
+/*
+  loadbench.cpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+
+  Compare reading a big file with mapping it, both cold (we ask the OS to 
+  drop the file from the cache first) and warm.
+
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+
+  https://github.com/visualopsholdings/dict
+*/
+
+#include "dict.hpp"
+#include "dictmmap.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <filesystem>
+#include <limits>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <boost/log/trivial.hpp>
+#include <boost/log/expressions.hpp>
+
+using namespace std;
+using namespace vops;
+namespace fs = std::filesystem;
+
+void dropCache(const string &fn) {
+
+  int fd = open(fn.c_str(), O_RDONLY);
+  if (fd >= 0) {
+    fdatasync(fd);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+  }
+  
+}
+
+template<typename F>
+void run(const string &name, const string &fn, F f) {
+
+  for (auto cold: { true, false }) {
+    if (cold) {
+      dropCache(fn);
+    }
+    auto start = chrono::steady_clock::now();
+    auto total = f();
+    auto end = chrono::steady_clock::now();
+    cout << name << (cold ? " cold: " : " warm: ") << chrono::duration_cast<chrono::milliseconds>(end - start).count() 
+      << "ms (" << total << ")" << endl;
+  }
+
+}
+
+int main() {
+
+  boost::log::core::get()->set_filter(boost::log::trivial::severity >= boost::log::trivial::warning);
+
+  auto fn = (fs::temp_directory_path() / "loadbench.json").string();
+  {
+    ofstream f(fn);
+    f << "[";
+    for (int i=0; f.tellp() < 100 * 1024 * 1024; i++) {
+      if (i > 0) {
+        f << ",";
+      }
+      f << "{\"id\":\"667d0baedfb1ed18430d" << i << "\",\"name\":\"item " << i << "\",\"value\":" << i 
+        << ",\"active\":" << (i % 2 ? "true" : "false") << ",\"tags\":[\"a\",\"b\",\"c\"]}";
+    }
+    f << "]";
+  }
+  cout << fs::file_size(fn) << " bytes" << endl;
+  
+  // just getting the bytes in.
+  run("read bytes    ", fn, [&fn]() {
+    MappedFile f(fn, numeric_limits<size_t>::max());
+    auto s = *f.data();
+    size_t total = 0;
+    for (auto c: s) {
+      total += (unsigned char)c;
+    }
+    return total;
+  });
+  run("mmap bytes    ", fn, [&fn]() {
+    MappedFile f(fn, 0);
+    auto s = *f.data();
+    size_t total = 0;
+    for (auto c: s) {
+      total += (unsigned char)c;
+    }
+    return total;
+  });
+  
+  // and parsing them.
+  Dict::setJSONParser(Dict::JSONParser::Simd);
+  Dict::setMmapThreshold(numeric_limits<size_t>::max());
+  run("read parseFile", fn, [&fn]() {
+    return Dict::parseFile(fn) ? 1 : 0;
+  });
+  Dict::setMmapThreshold(0);
+  run("mmap parseFile", fn, [&fn]() {
+    return Dict::parseFile(fn) ? 1 : 0;
+  });
+  
+  fs::remove(fn);
+  
+  return 0;
+
+}
@@ -0,0 +1,59 @@
+/*
+  ndjsonbench.cpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+
+  How reading NDJSON scales with the number of threads, up to the number of
+  cores or the number given.
+
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+
+  https://github.com/visualopsholdings/dict
+*/
+
+#include "dict.hpp"
+
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+
+using namespace std;
+using namespace vops;
+
+int main(int argc, char *argv[]) {
+
+  stringstream ss;
+  for (int i=0; i<200000; i++) {
+    ss << "{\"id\":\"667d0baedfb1ed18430d" << i << "\",\"name\":\"item " << i << "\",\"value\":" << i 
+      << ",\"active\":" << (i % 2 ? "true" : "false") << ",\"tags\":[\"a\",\"b\",\"c\"]}\n";
+  }
+  auto input = ss.str();
+  cout << input.size() << " bytes, " << thread::hardware_concurrency() << " cores" << endl;
+
+  int most = argc > 1 ? atoi(argv[1]) : max(1u, thread::hardware_concurrency());
+  
+  double first = 0;
+  for (int threads=1; threads<=most; threads*=2) {
+  
+    stringstream in(input);
+    size_t count = 0;
+    auto start = chrono::steady_clock::now();
+    Dict::readNDJSON(in, [&count](DictG &&g) {
+      count++;
+      return true;
+    }, threads);
+    auto end = chrono::steady_clock::now();
+    
+    double secs = chrono::duration<double>(end - start).count();
+    if (threads == 1) {
+      first = secs;
+    }
+    cout << threads << " threads: " << input.size() / secs / 1e6 << " MB/s, " << first / secs << "x (" << count << ")" << endl;
+  }
+
+  return 0;
+
+}
@@ -0,0 +1,133 @@
+/*
+  parsebench.cpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+
+  Compare the throughput of the rfl JSON parser with the SIMD one (with each
+  kernel) and the tape on a few different kinds of JSON.
+
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+
+  https://github.com/visualopsholdings/dict
+*/
+
+#include "dicttape.hpp"
+
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <cstring>
+
+#include <boost/log/trivial.hpp>
+#include <boost/log/expressions.hpp>
+
+using namespace std;
+using namespace vops;
+
+string makeRecords(int n) {
+
+  // lots of small objects, like a query result.
+  stringstream ss;
+  ss << "[";
+  for (int i=0; i<n; i++) {
+    if (i > 0) {
+      ss << ",";
+    }
+    ss << "{\"id\":\"667d0baedfb1ed18430d" << i << "\",\"name\":\"item " << i << "\",\"value\":" << i 
+      << ",\"active\":" << (i % 2 ? "true" : "false") << ",\"tags\":[\"a\",\"b\",\"c\"]}";
+  }
+  ss << "]";
+  return ss.str();
+
+}
+
+string makeText(int n) {
+
+  // long strings, with some escapes and non ASCII.
+  stringstream ss;
+  ss << "{\"paragraphs\":[";
+  for (int i=0; i<n; i++) {
+    if (i > 0) {
+      ss << ",";
+    }
+    ss << "\"Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore "
+      << "et dolore magna aliqua. \\\"Ut enim\\\" ad minim veniam, quis nostrud exercitation ullamco laboris "
+      << "nisi ut aliquip ex ea commodo consequat. Façade naïve café " << i << "\\n\"";
+  }
+  ss << "]}";
+  return ss.str();
+
+}
+
+string makeNumbers(int n) {
+
+  stringstream ss;
+  ss << "[";
+  for (int i=0; i<n; i++) {
+    if (i > 0) {
+      ss << ",";
+    }
+    ss << (i * 7919) << "," << (i * 0.001) << "," << -i;
+  }
+  ss << "]";
+  return ss.str();
+
+}
+
+template<typename F>
+void run(const string &name, const string &json, F f) {
+
+  // enough runs to get a good time.
+  int n = 1 + 200000000 / json.size();
+  auto start = chrono::steady_clock::now();
+  size_t total = 0;
+  for (int i=0; i<n; i++) {
+    total += f(json);
+  }
+  auto end = chrono::steady_clock::now();
+  
+  double secs = chrono::duration<double>(end - start).count();
+  cout << "  " << name << ": " << (json.size() * double(n)) / secs / 1e9 << " GB/s (" << total << ")" << endl;
+
+}
+
+int main() {
+
+  boost::log::core::get()->set_filter(boost::log::trivial::severity >= boost::log::trivial::warning);
+
+  vector<pair<string, string>> corpora = {
+    { "records", makeRecords(20000) },
+    { "text", makeText(5000) },
+    { "numbers", makeNumbers(50000) }
+  };
+  
+  auto best = Dict::simdKernel();
+  
+  for (auto &c: corpora) {
+  
+    cout << c.first << " (" << c.second.size() << " bytes)" << endl;
+    
+    Dict::setJSONParser(Dict::JSONParser::Rfl);
+    run("rfl        ", c.second, [](auto &s) {
+      return Dict::parseString(s) ? 1 : 0;
+    });
+    
+    for (auto k: { "scalar", "sse4.2", "avx2" }) {
+      if (!Dict::setSimdKernel(k)) {
+        continue;
+      }
+      run(string("simd ") + k + string(6 - strlen(k), ' '), c.second, [](auto &s) {
+        return Dict::parseSimd(s) ? 1 : 0;
+      });
+    }
+    Dict::setSimdKernel(best);
+    
+    run("tape       ", c.second, [](auto &s) {
+      return Dict::parseTape(s) ? 1 : 0;
+    });
+  }
+
+  return 0;
+
+}
@@ -0,0 +1,76 @@
+/*
+  patchbench.cpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+
+  Compare applying a JSON patch in one go with doing the same thing 
+  with lots of set_at_pointer calls.
+
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+
+  https://github.com/visualopsholdings/dict
+*/
+
+#include "dict.hpp"
+
+#include <iostream>
+#include <chrono>
+
+using namespace std;
+using namespace vops;
+
+DictG makeDoc() {
+
+  DictV items;
+  for (int i=0; i<1000; i++) {
+    items.push_back(dictO({ { "name", "item number " + to_string(i) }, { "value", i } }));
+  }
+  return dictO({ { "items", items } });
+
+}
+
+template<typename F>
+void run(const string &name, F f) {
+
+  auto start = chrono::steady_clock::now();
+  auto result = f();
+  auto end = chrono::steady_clock::now();
+
+  cout << name << ": " << chrono::duration_cast<chrono::microseconds>(end - start).count() << "us (" << result << ")" << endl;
+
+}
+
+int main() {
+
+  for (int n: { 10, 100, 1000 }) {
+  
+    cout << n << " ops" << endl;
+    
+    DictV ops;
+    for (int i=0; i<n; i++) {
+      ops.push_back(dictO({ 
+        { "op", "replace" }, 
+        { "path", "/items/" + to_string(i) + "/value" }, 
+        { "value", i * 2 } 
+      }));
+    }
+
+    run("  set_at_pointer", [&]() {
+      DictG doc = makeDoc();
+      for (int i=0; i<n; i++) {
+        doc = *Dict::set_at_pointer(doc, "/items/" + to_string(i) + "/value", i * 2);
+      }
+      return Dict(doc).object("items").vector(n-1).object("value").num();
+    });
+
+    run("  applyPatch    ", [&]() {
+      DictG doc = makeDoc();
+      Dict::applyPatch(doc, ops);
+      return Dict(doc).object("items").vector(n-1).object("value").num();
+    });
+  }
+  
+  return 0;
+
+}
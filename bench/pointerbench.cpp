@@ -0,0 +1,107 @@
+/*
+  pointerbench.cpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+
+  Compare finding with a string path to finding with a compiled Dict::Pointer.
+
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+
+  https://github.com/visualopsholdings/dict
+*/
+
+#include "dict.hpp"
+
+#include <iostream>
+#include <chrono>
+
+#include <boost/log/trivial.hpp>
+#include <boost/log/expressions.hpp>
+
+using namespace std;
+using namespace vops;
+
+DictG makeDoc() {
+
+  DictO root;
+  for (int i=0; i<10; i++) {
+    DictO section;
+    for (int j=0; j<10; j++) {
+      DictV list;
+      for (int k=0; k<10; k++) {
+        list.push_back(dictO({ { "name", "item" + to_string(k) }, { "value", k } }));
+      }
+      section["key" + to_string(j)] = list;
+    }
+    root["section" + to_string(i)] = section;
+  }
+  return root;
+
+}
+
+template<typename F>
+void run(const string &name, int n, F f) {
+
+  auto start = chrono::steady_clock::now();
+  size_t total = 0;
+  for (int i=0; i<n; i++) {
+    total += f();
+  }
+  auto end = chrono::steady_clock::now();
+
+  cout << name << ": " << chrono::duration_cast<chrono::microseconds>(end - start).count() << "us (" << total << ")" << endl;
+
+}
+
+int main() {
+
+  boost::log::core::get()->set_filter(boost::log::trivial::severity >= boost::log::trivial::warning);
+
+  DictG doc = makeDoc();
+  const int n = 10000;
+
+  vector<string> paths;
+  for (int i=0; i<30; i++) {
+    paths.push_back("/section" + to_string(i % 10) + "/key" + to_string((i * 3) % 10) + "/" + to_string(i % 10) + "/name");
+  }
+  vector<Dict::Pointer> pointers;
+  for (auto &p: paths) {
+    pointers.push_back(Dict::Pointer(p));
+  }
+
+  run("string path     ", n, [&]() {
+    size_t found = 0;
+    for (auto &p: paths) {
+      found += Dict::find_pointer(doc, p) ? 1 : 0;
+    }
+    return found;
+  });
+
+  run("compiled pointer", n, [&]() {
+    size_t found = 0;
+    for (auto &p: pointers) {
+      found += Dict::find_pointer(doc, p) ? 1 : 0;
+    }
+    return found;
+  });
+
+  run("compiled borrow ", n, [&]() {
+    size_t found = 0;
+    for (auto &p: pointers) {
+      found += Dict::find_pointer_ptr(doc, p) ? 1 : 0;
+    }
+    return found;
+  });
+
+  run("batch           ", n, [&]() {
+    size_t found = 0;
+    for (auto &r: Dict::findPointers(doc, pointers)) {
+      found += r.has_value() ? 1 : 0;
+    }
+    return found;
+  });
+
+  return 0;
+
+}
@@ -0,0 +1,108 @@
+/*
+  stringbench.cpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+
+  The string kernels (UTF-8 checking, escaping, and unescaping in parseSimd) with each
+  kind of SIMD, on mostly ASCII text (logs) and mostly multibyte text.
+
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+
+  https://github.com/visualopsholdings/dict
+*/
+
+#include "dict.hpp"
+#include "dictjson.hpp"
+
+#include <iostream>
+#include <chrono>
+#include <random>
+
+#include <boost/log/trivial.hpp>
+#include <boost/log/expressions.hpp>
+
+using namespace std;
+using namespace vops;
+
+string makeText(const vector<string> &words, size_t size) {
+
+  mt19937 rng(42);
+  string s;
+  while (s.size() < size) {
+    s += words[rng() % words.size()];
+  }
+  return s;
+  
+}
+
+template<typename F>
+void run(const string &name, size_t bytes, F f) {
+
+  // best of a few.
+  double best = 0;
+  for (int i=0; i<5; i++) {
+    auto start = chrono::steady_clock::now();
+    f();
+    auto end = chrono::steady_clock::now();
+    auto secs = chrono::duration<double>(end - start).count();
+    best = max(best, bytes / secs / 1e9);
+  }
+  cout << "    " << name << ": " << best << " GB/s" << endl;
+
+}
+
+int main() {
+
+  boost::log::core::get()->set_filter(boost::log::trivial::severity >= boost::log::trivial::warning);
+
+  const size_t size = 64 * 1024 * 1024;
+  vector<pair<string, string>> corpora = {
+    { "ascii", makeText({ "2026-10-18T06:57:42 ", "[info] ", "request ", "GET /api/v1/items?id=1234 ", "took 12ms ", 
+        "user=\"paul\" ", "status=200\\n" }, size) },
+    { "multibyte", makeText({ "日本語のテキスト", "中文文本", "Ελληνικά ", "русский текст ", "😀🎉", "é" }, size) }
+  };
+  
+  for (auto &c: corpora) {
+    auto &text = c.second;
+    
+    // the JSON for a vector of strings made out of it.
+    DictV v;
+    for (size_t i=0; i<text.size(); ) {
+      // don't split a character.
+      auto end = min(i + 4096, text.size());
+      while (end < text.size() && (text[end] & 0xC0) == 0x80) {
+        end++;
+      }
+      v.push_back(text.substr(i, end - i));
+      i = end;
+    }
+    DictG g = v;
+    string json;
+    Dict::write(g, [&json](string_view s) { json += s; return true; }, false);
+    
+    cout << c.first << endl;
+    for (auto k: { "avx2", "sse4.2", "scalar" }) {
+      if (!Dict::setSimdKernel(k)) {
+        continue;
+      }
+      cout << "  " << k << endl;
+      run("validUTF8", text.size(), [&text]() {
+        if (!json::validUTF8(text)) {
+          cout << "invalid!" << endl;
+        }
+      });
+      run("escape   ", text.size(), [&g]() {
+        Dict::write(g, [](string_view) { return true; }, false);
+      });
+      run("parseSimd", json.size(), [&json]() {
+        if (!Dict::parseSimd(json)) {
+          cout << "failed!" << endl;
+        }
+      });
+    }
+  }
+  
+  return 0;
+
+}
@@ -0,0 +1,131 @@
+/*
+  symbolbench.cpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+
+  How much memory is saved by interning the keys? We parse an array of
+  lots of objects that all have the same keys, which is what most of our
+  payloads look like, into a DictG and into a DictP and count the bytes 
+  allocated.
+
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+
+  https://github.com/visualopsholdings/dict
+*/
+
+#include "dictp.hpp"
+
+#include <iostream>
+#include <sstream>
+#include <new>
+#include <cstdlib>
+
+using namespace std;
+using namespace vops;
+
+static size_t bytes = 0;
+
+void *operator new(size_t size) {
+  bytes += size;
+  void *p = malloc(size);
+  if (!p) {
+    throw bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void *p) noexcept {
+  free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+  free(p);
+}
+
+string makeCorpus(int n) {
+
+  vector<string> keys = { "id", "name", "description", "created_at", "modified_by_user", 
+    "owner_organisation", "status", "priority", "tags", "parent_identifier" };
+  stringstream ss;
+  ss << "[";
+  for (int i=0; i<n; i++) {
+    if (i > 0) {
+      ss << ",";
+    }
+    ss << "{";
+    for (size_t k=0; k<keys.size(); k++) {
+      if (k > 0) {
+        ss << ",";
+      }
+      ss << "\"" << keys[k] << "\":" << i + k;
+    }
+    ss << "}";
+  }
+  ss << "]";
+  return ss.str();
+
+}
+
+size_t keyBytes(const DictG &g) {
+
+  size_t total = 0;
+  auto obj = Dict::getObjectPtr(g);
+  if (obj) {
+    for (auto &e: *obj) {
+      total += sizeof(std::string) + (e.first.size() > 15 ? e.first.capacity() + 1 : 0) + keyBytes(e.second);
+    }
+    return total;
+  }
+  auto vec = Dict::getVectorPtr(g);
+  if (vec) {
+    for (auto &e: *vec) {
+      total += keyBytes(e);
+    }
+  }
+  return total;
+
+}
+
+int main() {
+
+  const int n = 20000;
+  auto corpus = makeCorpus(n);
+  
+  size_t before = bytes;
+  auto g = Dict::parseString(corpus);
+  if (!g) {
+    cout << "couldn't parse" << endl;
+    return 1;
+  }
+  size_t gparse = bytes - before;
+  
+  before = bytes;
+  auto p = DictP::parseString(corpus);
+  if (!p) {
+    cout << "couldn't parse" << endl;
+    return 1;
+  }
+  size_t pparse = bytes - before;
+  
+  // copying allocates exactly what's kept.
+  before = bytes;
+  DictG gcopy = *g;
+  size_t gbytes = bytes - before;
+  
+  before = bytes;
+  DictP pcopy(*g);
+  size_t pbytes = bytes - before;
+  
+  auto gkeys = keyBytes(*g);
+  auto pkeys = n * 10 * sizeof(Symbol) + Symbols::global().bytes();
+  
+  cout << n << " objects, " << corpus.size() << " bytes of JSON" << endl;
+  cout << "DictG: " << gbytes << " bytes, " << gkeys << " for keys, " << gparse << " allocated parsing" << endl;
+  cout << "DictP: " << pbytes << " bytes, " << pkeys << " for keys (" << Symbols::global().size() << " symbols), " 
+    << pparse << " allocated parsing" << endl;
+  cout << "saved: " << gbytes - pbytes << " bytes, " << gkeys - pkeys << " of them keys" << endl;
+
+  return 0;
+
+}
@@ -0,0 +1,118 @@
+/*
+  tapebench.cpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+
+  Compare parsing to a DictG and walking it with parsing to a DictTape 
+  and walking that. We count the allocations too.
+
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+
+  https://github.com/visualopsholdings/dict
+*/
+
+#include "dicttape.hpp"
+
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <new>
+#include <cstdlib>
+
+using namespace std;
+using namespace vops;
+
+static size_t allocs = 0;
+
+void *operator new(size_t size) {
+  allocs++;
+  void *p = malloc(size);
+  if (!p) {
+    throw bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void *p) noexcept {
+  free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+  free(p);
+}
+
+string makeCorpus(int n) {
+
+  stringstream ss;
+  ss << "[";
+  for (int i=0; i<n; i++) {
+    if (i > 0) {
+      ss << ",";
+    }
+    ss << "{\"id\":\"667d0baedfb1ed18430d" << i << "\",\"name\":\"item " << i << "\",\"value\":" << i 
+      << ",\"active\":" << (i % 2 ? "true" : "false") << ",\"tags\":[\"a\",\"b\",\"c\"],"
+      << "\"owner\":{\"name\":\"someone with a long name\",\"level\":" << i % 10 << "}}";
+  }
+  ss << "]";
+  return ss.str();
+
+}
+
+template<typename F>
+void run(const string &name, int n, F f) {
+
+  size_t before = allocs;
+  auto start = chrono::steady_clock::now();
+  size_t total = 0;
+  for (int i=0; i<n; i++) {
+    total += f();
+  }
+  auto end = chrono::steady_clock::now();
+
+  cout << name << ": " << chrono::duration_cast<chrono::microseconds>(end - start).count() / n << "us, "
+    << (allocs - before) / n << " allocations (" << total << ")" << endl;
+
+}
+
+int main() {
+
+  auto corpus = makeCorpus(10000);
+  const int n = 20;
+  
+  cout << corpus.size() << " bytes of JSON" << endl;
+
+  run("parse DictG   ", n, [&]() {
+    auto g = Dict::parseString(corpus);
+    return g ? 1 : 0;
+  });
+
+  run("parse DictTape", n, [&]() {
+    auto t = Dict::parseTape(corpus);
+    return t ? 1 : 0;
+  });
+
+  auto g = Dict::parseString(corpus);
+  auto t = Dict::parseTape(corpus);
+  
+  run("walk DictG    ", n, [&]() {
+    size_t total = 0;
+    for (auto &e: *Dict::getVectorPtr(*g)) {
+      auto level = Dict::getNum(Dict::getObjectPtr(Dict::getObjectPtr(e), "owner"), "level");
+      total += level ? *level : 0;
+    }
+    return total;
+  });
+
+  run("walk DictTape ", n, [&]() {
+    size_t total = 0;
+    for (auto e: t->root()) {
+      auto level = e.object("owner").object("level").getNum();
+      total += level ? *level : 0;
+    }
+    return total;
+  });
+
+  return 0;
+
+}
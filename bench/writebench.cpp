@@ -0,0 +1,84 @@
+/*
+  writebench.cpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+
+  Write a big document out to a file with toString and with write. The peak
+  memory only ever goes up, so write is done first.
+
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+
+  https://github.com/visualopsholdings/dict
+*/
+
+#include "dict.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <filesystem>
+#include <sys/resource.h>
+
+#include <boost/log/trivial.hpp>
+#include <boost/log/expressions.hpp>
+
+using namespace std;
+using namespace vops;
+namespace fs = std::filesystem;
+
+long peakMB() {
+
+  rusage r;
+  getrusage(RUSAGE_SELF, &r);
+  return r.ru_maxrss / 1024;
+  
+}
+
+template<typename F>
+void run(const string &name, F f) {
+
+  auto before = peakMB();
+  auto start = chrono::steady_clock::now();
+  f();
+  auto end = chrono::steady_clock::now();
+  cout << name << ": " << chrono::duration_cast<chrono::milliseconds>(end - start).count() 
+    << "ms, peak memory +" << (peakMB() - before) << "MB" << endl;
+
+}
+
+int main() {
+
+  boost::log::core::get()->set_filter(boost::log::trivial::severity >= boost::log::trivial::warning);
+
+  DictV v;
+  for (int i=0; i<500000; i++) {
+    v.push_back(dictO({
+      { "id", "667d0baedfb1ed18430d" + to_string(i) },
+      { "name", "item \"" + to_string(i) + "\"" },
+      { "value", i },
+      { "active", i % 2 == 0 },
+      { "tags", DictV{ "a", "b", "c" } }
+    }));
+  }
+  DictG g = v;
+  auto fn = (fs::temp_directory_path() / "writebench.json").string();
+  
+  for (auto pretty: { false, true }) {
+    cout << (pretty ? "pretty" : "compact") << endl;
+    run("  write   ", [&]() {
+      ofstream f(fn);
+      Dict::write(g, f, pretty);
+    });
+    run("  toString", [&]() {
+      ofstream f(fn);
+      f << Dict::toString(g, pretty);
+    });
+  }
+  cout << fs::file_size(fn) << " bytes" << endl;
+  
+  fs::remove(fn);
+  
+  return 0;
+
+}
@@ -16,12 +16,20 @@
 
 #include "dictresult.hpp"
 
+#include <atomic>
+#include <unordered_map>
+#include <mutex>
+
 namespace vops {
 
+class DictTape;
+class DictLazy;
+class DictIncludes;
+
 class Dict {
 
 public:
-  Dict(std::optional<DictG> g): _dict(g) {}
+  Dict(std::optional<DictG> g): _dict(std::move(g)) {}
   Dict() {}
   
   static std::optional<DictO> getObject(const DictG &obj);
@@ -48,6 +56,12 @@ public:
   static std::optional<DictV> getVector(rfl::Result<DictG> result);
     // given a generic object, get a vector out of it.
 
+  static const DictO *getObjectPtr(const DictG &obj);
+  static const DictV *getVectorPtr(const DictG &obj);
+  static std::optional<std::string_view> getStringView(const DictG &obj);
+    // borrowing versions of the getters above. Nothing is copied, the result 
+    // points into obj and is only good for as long as obj is.
+
   static std::optional<DictO> getObjectG(std::optional<DictG> g, const std::string &name);
   static std::optional<DictO> getObject(std::optional<DictO> dict, const std::string &name);
     // get an object out of the dictionary with the property name.
@@ -78,25 +92,225 @@ public:
     // get a string out of the dictionary with the property name.
     // This is chainable.
 
+  static const DictG *getGenericPtr(const DictO *dict, std::string_view name);
+  static const DictO *getObjectPtr(const DictO *dict, std::string_view name);
+  static const DictV *getVectorPtr(const DictO *dict, std::string_view name);
+  static std::optional<std::string_view> getStringView(const DictO *dict, std::string_view name);
+  static std::optional<long long> getNum(const DictO *dict, std::string_view name);
+  static std::optional<bool> getBool(const DictO *dict, std::string_view name);
+    // borrowing versions of the property getters. These are chainable and never copy:
+    //   Dict::getStringView(Dict::getObjectPtr(Dict::getObjectPtr(g), "a"), "b");
+    // A null dict just passes through as "not found".
+
   static std::string toString(const DictG &g, bool pretty=true, const std::string &format=".json");
-    // dump the generic out as JSON or YML.
+    // dump the generic out as JSON or YML, or .bson, .msgpack or .cbor if we were 
+    // built with them (the string is just the bytes).
+
+  static bool hasFormat(const std::string &format);
+    // we can read and write this format. They are all in DictCodec, which is where
+    // you add your own.
+
+  typedef std::function<bool (std::string_view)> Sink;
+  
+  static bool write(const DictG &g, std::ostream &s, bool pretty=true, const std::string &format=".json", size_t chunk=65536);
+  static bool write(const DictG &g, const Sink &sink, bool pretty=true, const std::string &format=".json", size_t chunk=65536);
+  static bool write(const DictG &g, std::span<char> buffer, const Sink &sink, bool pretty=true, const std::string &format=".json");
+    // write it out a chunk at a time as it goes, so only a chunk is ever in memory. The 
+    // sink is given each chunk as the buffer fills up, return false to stop. 
+    //
+    // JSON is laid out the same as toString, YML is always block style with all the 
+    // strings quoted. Formats that can't do that are made in one go and then written out.
 
   template<typename T>
   static std::optional<DictG> parse(T &s, const std::string &format);
   
   static std::optional<DictG> parseString(const std::string &s, const std::string &format=".json");
   static std::optional<DictG> parseStream(std::istream &s, const std::string &format=".json");
-  static std::optional<DictG> parseFile(const std::string &fn, bool silentinclude=false);
-    // given a stream, and a format the stream is in (.json, .yml) parse it.
+  static std::optional<DictG> parseFile(const std::string &fn, bool silentinclude=false, int threads=1);
+    // given a stream, and a format the stream is in (.json, .yml, .bson, .msgpack,
+    // .cbor) parse it. A file's format is its extension.
+    //
+    // If the format is "" (or a file's extension isn't one we know) it's worked
+    // out from what's there.
+    // 
+    // For a file, more threads (0 is one for each core) finds all of the included
+    // files first and loads them in parallel, you get exactly the same thing.
+    
+  static std::optional<DictG> parseFile(const std::string &fn, DictIncludes &includes);
+    // parse a file and keep all of the files it included so it can be reloaded.
+    
+  static void setMmapThreshold(size_t bytes);
+  static size_t getMmapThreshold();
+    // JSON files at least this big (1MB by default) are mapped into memory and
+    // parsed straight from there. Smaller ones are just read.
+    
+  static bool streamArray(std::istream &s, std::function<bool (DictG &&)> callback, size_t chunk=65536);
+    // the stream is a JSON array. Parse one element at a time and call callback with it,
+    // so only the element is ever in memory. Return false from the callback to stop.
+    // Returns false if the JSON is bad.
+    
+  static bool readNDJSON(std::istream &s, std::function<bool (DictG &&)> callback, int threads=1, size_t chunk=1048576);
+  static std::optional<DictV> readNDJSON(std::istream &s, int threads=1);
+    // read newline delimited JSON (one record on each line), calling callback with each
+    // record in order. With more than one thread (0 is one for each core) the input is
+    // split into chunks of lines which are parsed in parallel. Return false from the 
+    // callback to stop. Returns false if a line is bad.
+    
+  static bool writeNDJSON(std::ostream &s, const DictV &records);
+    // write the records out one to a line. Returns false if a record or the stream
+    // fails, what was written before it is still there.
+    
+  enum class JSONParser { Rfl, Simd };
+  static void setJSONParser(JSONParser parser);
+  static JSONParser getJSONParser();
+    // which parser parseString, parseStream and parseFile use for JSON. It's Simd
+    // unless we were built with DICT_SIMD_PARSER off.
+    
+  static std::optional<DictG> parseSimd(std::string_view s);
+    // parse JSON with the SIMD parser, whatever the setting.
+    
+  static std::string simdKernel();
+  static bool setSimdKernel(const std::string &name);
+    // the SIMD the parser, string escaping and UTF-8 checks are using ("avx2", 
+    // "sse4.2" or "scalar"). It picks the best one the CPU has, but you can change it,
+    // even while other threads are parsing.
+    
+  static std::optional<DictTape> parseTape(const std::string &s);
+    // parse JSON straight into a DictTape (include "dicttape.hpp").
+    
+  static std::optional<DictLazy> parseLazy(std::string s);
+    // just index the JSON, and only parse what you look at (include "dictlazy.hpp").
     
+  class Pointer {
+  
+    // A JSON pointer (RFC 6901) that has been broken up into tokens ahead of time
+    // so it can be used over and over again on different documents. "~0" and "~1" 
+    // are decoded and anything that looks like an array index is turned into a number.
+    
+  public:
+    explicit Pointer(const std::string &path);
+    
+    struct Token {
+      std::string key;
+      std::optional<size_t> index;
+    };
+    typedef std::vector<Token>::const_iterator const_iterator;
+    
+    bool valid() const { return _valid; }
+      // false if the path couldn't be parsed. It's already been logged.
+      
+    const std::string &path() const { return _path; }
+    const_iterator begin() const { return _tokens.begin(); }
+    const_iterator end() const { return _tokens.end(); }
+    size_t size() const { return _tokens.size(); }
+    
+  private:
+    std::string _path;
+    std::vector<Token> _tokens;
+    bool _valid;
+    
+  };
+  
   static std::optional<DictG> find_pointer(const DictG &g, const std::string &path);
+  static std::optional<DictG> find_pointer(const DictG &g, const Pointer &path);
   static std::optional<DictG> set_at_pointer(const DictG &g, const std::string &path, const DictG &value);
+  static std::optional<DictG> set_at_pointer(const DictG &g, const Pointer &path, const DictG &value);
     // boost::json style find pointer, except set_at_pointer returns a new value.
+    // An empty path is the whole document.
+    
+  static std::optional<DictG> set_at_pointer(DictG &&g, const std::string &path, const DictG &value);
+  static std::optional<DictG> set_at_pointer(DictG &&g, const Pointer &path, const DictG &value);
+    // if you don't need the old document, everything is moved into the new one.
+    
+  static bool set_at_pointer_in_place(DictG &g, const std::string &path, DictG &&value);
+  static bool set_at_pointer_in_place(DictG &g, const Pointer &path, DictG &&value);
+    // change the document itself, only the path to the value is visited.
+    // returns false (and leaves g alone) if the path is bad.
+    
+  static const DictG *find_pointer_ptr(const DictG &g, const Pointer &path);
+    // borrowing version of find_pointer.
+
+  static std::vector<Result> findPointers(const DictG &g, const std::vector<Pointer> &pointers);
+  static std::vector<Result> findPointers(const DictG &g, const std::vector<std::string> &paths);
+    // find lots of pointers at once. Paths that share a prefix share the walk so
+    // the document is only walked once. You get a Result for each pointer in
+    // the same order, in error if it's missing or the wrong type on the way.
+
+  static bool applyPatch(DictG &g, const DictV &ops);
+    // apply a JSON patch (RFC 6902) to g in place. If any of the operations fail
+    // (including a "test") all the changes are put back and it returns false.
+    
+  static void mergePatch(DictG &target, DictG &&patch);
+    // apply a JSON Merge Patch (RFC 7386) to target in place. A null in the patch
+    // removes the key. Everything in the patch is moved into the target.
+    
+  static DictG deepMerge(std::vector<DictG> &&layers);
+    // merge patch each layer on top of the one before, so you can have a base
+    // and then overrides etc.
+    
+  static bool equals(const DictG &a, const DictG &b);
+    // deep compare. Numbers are compared by value and the order of keys doesn't matter.
 
   static DictO removeKey(const DictO &m, const std::string &key);
   static DictO filterKeys(const DictO &m, const std::vector<std::string> &keys);
     // why is these so hard to do!!!! added methods to do it.
     
+  class Index {
+  
+    // An index on a big object so looking up a key is O(1) rather than a scan.
+    // It's built the first time you look something up, and only if the object has 
+    // more than "threshold" keys. Small objects are just scanned.
+    //
+    // The object keeps it's order. The index only tracks this one object and is
+    // only used when you look things up through get(), the getters and pointers still 
+    // scan. Change the object through the index to keep it up to date. If you change 
+    // it any other way (a pointer, a patch etc), call changed(). Keys added on the end 
+    // are noticed anyway, but otherwise a key it doesn't have isn't there.
+    //
+    // Once it's built, lots of threads can look things up at once.
+    //
+    // Like an iterator it's only good while the object stays where it is, and adding 
+    // to whatever the object is in can move it.
+    
+  public:
+    Index(DictO &obj, size_t threshold=32): _obj(&obj), _mobj(&obj), _threshold(threshold) {}
+    Index(const DictO &obj, size_t threshold=32): _obj(&obj), _mobj(nullptr), _threshold(threshold) {}
+    Index(const DictO &&obj, size_t threshold=32) = delete;
+    Index(const Index &) = delete;
+    Index &operator=(const Index &) = delete;
+    
+    const DictG *get(std::string_view key) const;
+      // the value with that key, or null if it's not there.
+      
+    bool set(const std::string &key, DictG &&value);
+      // replace the value, or add it to the end.
+      
+    bool remove(const std::string &key);
+      // remove the key, everything else stays in order.
+      
+    void changed();
+      // the object was changed underneath us, so start again.
+      
+  private:
+    struct Hash {
+      using is_transparent = void;
+      size_t operator()(std::string_view s) const { return std::hash<std::string_view>()(s); }
+    };
+    
+    std::optional<size_t> find(std::string_view key) const;
+    std::optional<size_t> scan(std::string_view key) const;
+    void build() const;
+    
+    const DictO *_obj;
+    DictO *_mobj;
+    size_t _threshold;
+    mutable std::mutex _mutex;
+    mutable std::unordered_map<std::string, size_t, Hash, std::equal_to<>> _index;
+    mutable std::atomic<size_t> _indexed = 0;
+    mutable std::atomic<bool> _stale = true;
+    
+  };
+  
   static std::optional<std::string> getFirstKey(const DictO &d);
     // get the ery first key of a dictionary.
     
@@ -124,18 +338,81 @@ public:
   }
 
 private:    
+  friend class DictIncludes;
+  friend class DictPatcher;
 
-  static std::optional<DictG> getGPath(const DictG &g, const std::string &path);
-  static std::optional<DictG> getVecPath(const DictV &v, const std::string &path);
-  static std::optional<DictG> getObjPath(const DictO &obj, const std::string &path);
-  static std::optional<DictG> setGPath(const DictG &g, const std::string &path, const DictG &value);
-  static std::optional<DictO> setObjPath(const DictO &obj, const std::string &path, const DictG &value);
-  static std::optional<DictV> setVecPath(const DictV &v, const std::string &path, const DictG &value);
+  static std::optional<DictG> loadFile(const std::string &fn, size_t *hash=nullptr);
+    // just this file, without any of it's includes.
+    
+  typedef Pointer::const_iterator TokenIter;
+  static const DictG *getGPath(const DictG &g, TokenIter i, TokenIter end);
+  static const DictG *getVecPath(const DictV &v, TokenIter i, TokenIter end);
+  static const DictG *getObjPath(const DictO &obj, TokenIter i, TokenIter end);
+  static bool setGPath(DictG &g, TokenIter i, TokenIter end, DictG &&value);
+  static bool setObjPath(DictO &obj, TokenIter i, TokenIter end, DictG &&value);
+  static bool setVecPath(DictV &v, TokenIter i, TokenIter end, DictG &&value);
+  static DictG *getMutablePtr(DictO &obj, std::string_view name);
+  static DictG *getMutablePath(DictG &g, TokenIter i, TokenIter end);
+  
+  static std::optional<size_t> eraseKey(DictO &obj, std::string_view key, DictG *removed=nullptr);
+    // take the key out of obj (moving it into removed), and say where it was.
+  static void insertKey(DictO &obj, size_t pos, const std::string &key, DictG &&value);
+    // and put it back there.
 
   std::optional<DictG> _dict;
   
 };
 
+class DictRef {
+
+  // The same monad entry points as Dict, except the document is borrowed or
+  // shared rather than copied in so making one of these costs nothing. You get
+  // a ResultRef back so the walk doesn't copy either.
+  //
+  //   DictRef(doc).object("hello").vector(3).string();
+  
+public:
+  DictRef(const DictG &g): _result(g) {}
+    // borrow g. It must outlive this and any result made from it.
+    
+  DictRef(DictG &&g): _result(std::move(g)) {}
+    // take ownership of a temporary.
+    
+  template<typename T> requires std::same_as<std::remove_cvref_t<T>, std::optional<DictG>>
+  DictRef(T &&g): _result(std::forward<T>(g)) {}
+    // borrow an optional, or own it if it's a temporary.
+    
+  DictRef(std::shared_ptr<const DictG> g): _result(g) {}
+    // share ownership of the document.
+  
+  // monad entry points.
+  ResultRef object(const std::string &key) {
+    return _result.object(key);
+  }
+  DictO object() {
+    return _result.object();
+  }
+  ResultRef vector(int index) {
+    return _result.vector(index);
+  }
+  DictV vector() {
+    return _result.vector();
+  }
+  std::string string() {
+    return _result.string();
+  }
+  int size() {
+    return _result.size();
+  }
+  bool error() {
+    return !_result.has_value();
+  }
+  
+private:
+  ResultRef _result;
+  
+};
+
 // a really helpful function for initialising DictO's because they don't accept
 // map initilisers.
 // this allows:
@@ -0,0 +1,42 @@
+/*
+  dictbinary.hpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+
+  The binary formats (.bson, .msgpack and .cbor) that reflect-cpp can do. Each
+  one is only there if we were built with it (DICT_BSON, DICT_MSGPACK and DICT_CBOR)
+  and reflect-cpp was too. They are added to DictCodec when it starts.
+
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+
+  https://github.com/visualopsholdings/dict
+*/
+
+#ifndef H_dictbinary
+#define H_dictbinary
+
+#include "dictresult.hpp"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace vops {
+
+namespace binary {
+
+std::vector<std::string> formats();
+  // the ones we were built with.
+
+std::optional<DictG> parse(std::string_view s, const std::string &format);
+  // parse the bytes. Logs why not if it can't.
+
+std::optional<std::string> write(const DictG &g, const std::string &format);
+  // the bytes. BSON has to be an object.
+
+} // binary
+
+} // vops
+
+#endif // H_dictbinary
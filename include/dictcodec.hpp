@@ -0,0 +1,80 @@
+/*
+  dictcodec.hpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+
+  All of the formats that toString, write and the parse functions know about.
+
+  Each codec is registered under its format (".json") and gets an id. Adding one
+  with a format that is already there replaces it (and it keeps the id), so you can
+  plug in your own faster JSON, or something new altogether, without changing
+  anything else.
+
+  When the format isn't known, the codecs are asked in turn (the last one added
+  first) whether the start of it looks right, and the first one that parses it wins.
+
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+
+  https://github.com/visualopsholdings/dict
+*/
+
+#ifndef H_dictcodec
+#define H_dictcodec
+
+#include "dict.hpp"
+
+#include <memory>
+
+namespace vops {
+
+class DictCodec {
+
+public:
+  typedef std::function<std::optional<DictG> (std::string_view s)> Parse;
+  typedef std::function<std::optional<std::string> (const DictG &g, bool pretty)> Write;
+  typedef std::function<bool (const DictG &g, bool pretty, std::span<char> buffer, const Dict::Sink &sink)> Stream;
+  typedef std::function<bool (std::string_view s)> Sniff;
+
+  std::string format;
+    // what it's known by, which is also a file extension (".json").
+  Parse parse;
+  Write write;
+    // these have to be there. Return nothing if it can't be done.
+  Stream stream;
+    // write into the buffer a chunk at a time. If there isn't one, Dict::write
+    // uses "write" and hands it over a chunk at a time.
+  Sniff sniff;
+    // could this be one of ours? It's just given the whole thing, but it should only
+    // look at the start. If there isn't one, it's never picked.
+
+  typedef int Id;
+
+  static Id add(DictCodec codec);
+    // add a codec (or replace the one with the same format).
+
+  static std::optional<Id> find(const std::string &format);
+  static std::shared_ptr<const DictCodec> get(Id id);
+  static std::shared_ptr<const DictCodec> get(const std::string &format);
+    // look one up. Getting it once by id and keeping it is the quickest. What you get
+    // is good for as long as you keep it, even if it's replaced.
+
+  static std::vector<std::shared_ptr<const DictCodec>> sniffAll(std::string_view s);
+    // all of the codecs it might be, in the order to try them.
+
+  static std::vector<std::string> formats();
+    // everything we know about.
+
+};
+
+namespace codec {
+
+bool writeJSON(const DictG &g, bool pretty, std::span<char> buffer, const Dict::Sink &sink);
+bool writeYAML(const DictG &g, bool pretty, std::span<char> buffer, const Dict::Sink &sink);
+  // the streaming writers the built in codecs use (in dictwrite.cpp).
+
+} // codec
+
+} // vops
+
+#endif // H_dictcodec
@@ -0,0 +1,105 @@
+/*
+  dictincludes.hpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+
+  All of the files that make up a document that uses includes.
+
+  Each file has it's modification time and a hash of what was in it, and which
+  files it includes. A file that ends up including itself is an error, and that
+  include is just left out.
+
+  Once you have parsed a file, reload() looks at all the files again and only
+  parses the ones that changed. The files that include them are put back together
+  from what is kept here, everything else is just reused.
+
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+
+  https://github.com/visualopsholdings/dict
+*/
+
+#ifndef H_dictincludes
+#define H_dictincludes
+
+#include "dict.hpp"
+
+#include <filesystem>
+#include <set>
+
+namespace vops {
+
+class DictIncludes {
+
+public:
+  DictIncludes(bool silentinclude=false, int threads=1): _silent(silentinclude), _threads(threads) {}
+    // the same as the arguments to Dict::parseFile.
+
+  struct File {
+    std::filesystem::path dir;
+      // where the includes in this file are relative to.
+    std::filesystem::file_time_type mtime;
+    size_t hash = 0;
+    std::vector<std::string> includes;
+      // the canonical paths of the files this one includes.
+    std::vector<std::pair<std::string, std::string>> sites;
+      // each file it includes and the JSON pointer to where.
+    std::optional<DictG> doc;
+      // as it was parsed.
+    std::optional<DictG> resolved;
+      // with all of the includes put in.
+
+    enum class State { Unloaded, Loaded, Stale, Resolving, Resolved };
+    State state = State::Unloaded;
+  };
+
+  std::optional<DictG> parseFile(const std::string &fn);
+    // parse the file, remembering all the files that were included.
+
+  const std::optional<DictG> &reload(bool *changed=nullptr);
+    // parse any files that have changed since and put the document back together.
+    // If a file that changed doesn't parse, you get nothing and everything is left as
+    // it was so you can try again.
+    //
+    // The document is kept in here and changed in place next time, so copy it if 
+    // you want to keep it, or release() it.
+
+  std::optional<DictG> release();
+    // move the document out of here rather than copying it. The next reload
+    // puts it back together from the files.
+
+  void invalidate(const std::string &fn);
+    // make the next reload look at this file even if it doesn't look like it
+    // changed (when the time stamps are too coarse to tell).
+
+  const std::string &root() const { return _root; }
+  const std::unordered_map<std::string, File> &files() const { return _files; }
+    // all of the files by their canonical path.
+    
+  const std::set<std::string> &missing() const { return _missing; }
+    // includes that aren't there. When one turns up, the next reload puts it in.
+
+private:
+  friend class Dict;
+
+  static File load(const std::string &key, bool hash);
+  std::optional<DictG> parse(const std::string &fn, bool keep);
+  void loadIncludes();
+  const std::optional<DictG> &include(const std::string &key);
+  DictG resolve(const std::filesystem::path &dir, DictG &&g, File *f, std::string *path);
+  bool splice(File *f);
+  void prune();
+
+  bool _silent;
+  int _threads;
+  bool _keep = true;
+  std::string _root;
+  std::unordered_map<std::string, File> _files;
+  std::set<std::string> _dirty;
+  std::set<std::string> _missing;
+
+};
+
+} // vops
+
+#endif // H_dictincludes
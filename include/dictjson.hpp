@@ -0,0 +1,314 @@
+/*
+  dictjson.hpp
+  
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+    
+  The bits of parsing JSON that our own parsers share, and the one parser
+  they all use.
+    
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+ 
+  https://github.com/visualopsholdings/dict
+*/
+
+#ifndef H_dictjson
+#define H_dictjson
+
+#include "dictresult.hpp"
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+namespace vops {
+
+namespace json {
+
+const char *unescape(std::string_view s, size_t *i, std::string *out);
+  // s[*i] is just after the opening quote. Append the string to out and leave
+  // *i just after the closing quote. Returns the error or null.
+  
+struct Number {
+  bool integer;
+  int64_t num;
+  double d;
+};
+
+const char *number(std::string_view s, size_t *i, Number *n);
+  // parse the number at s[*i] and leave *i after it. Returns the error or null.
+  // It's only an integer if it's written like one and fits.
+  
+void appendUTF8(std::string *out, unsigned cp);
+  // append the code point as UTF-8.
+  
+bool validUTF8(std::string_view s);
+  // is s valid UTF-8?
+  
+size_t findEscape(std::string_view s, size_t i);
+  // the first character from s[i] on that has to be escaped in a JSON string,
+  // or s.size() if there isn't one.
+  
+bool validUTF8Scalar(std::string_view s);
+size_t findEscapeScalar(std::string_view s, size_t i);
+  // validUTF8 and findEscape without SIMD. Those use the same SIMD as the parser
+  // (see Dict::setSimdKernel).
+  
+std::string_view escaped(char c, char *buf);
+  // the escape for c, buf must be at least 6 long and is used for \u escapes.
+  
+const char *structuralIndex(std::string_view s, std::vector<uint32_t> *index);
+  // the first stage of the SIMD parser, the position of every structural
+  // character, string and scalar in s. The strings and UTF-8 are checked.
+  // Returns the error or null.
+  
+bool index(std::string_view s, std::vector<uint32_t> *index);
+  // structuralIndex, but it logs why it failed and it checks s isn't too big
+  // for it.
+  
+bool fail(std::string_view s, const std::vector<uint32_t> &index, size_t n, const std::string &msg);
+  // log that we couldn't parse at index[n] and return false.
+  
+bool build(std::string_view s, const std::vector<uint32_t> &index, size_t *n, DictG *out);
+  // the second stage of the SIMD parser, make the DictG for the value that 
+  // starts at index[*n] and leave *n after it.
+  
+template<typename B>
+class Parser {
+
+  // The second stage of the SIMD parser, which walks the structural index and
+  // tells a builder what it finds. This is the only JSON grammar we have, so
+  // DictG, DictP and DictTape are just different builders:
+  //
+  //   Value                 what a value is built into.
+  //   Object, Vector, Key   an object, vector or key being built.
+  //   Object beginObject()
+  //   Key key(std::string_view k)
+  //   void member(Object &o, Key &&k, Value &&v)
+  //   void endObject(Object &o, Value *out)
+  //   Vector beginVector()
+  //   void element(Vector &v, Value &&e)
+  //   void endVector(Vector &v, Value *out)
+  //   void string(std::string_view s, Value *out)
+  //   void number(const Number &n, Value *out)
+  //   void boolean(bool b, Value *out)
+  //   void null(Value *out)
+  //
+  // Strings are only good for the call, keep a copy.
+  
+public:
+  typedef typename B::Value Value;
+  
+  Parser(std::string_view s, const std::vector<uint32_t> &index, B &b, size_t n=0): 
+    _s(s), _index(index), _b(b), _n(n) {}
+  
+  bool parse(Value *out) {
+    if (!value(out, 0)) {
+      return false;
+    }
+    if (_n != _index.size()) {
+      return fail("extra characters at the end");
+    }
+    return true;
+  }
+    // the whole of s is one value.
+    
+  bool parseValue(Value *out, size_t *n) {
+    if (!value(out, 0)) {
+      return false;
+    }
+    *n = _n;
+    return true;
+  }
+    // just the value at index[n], and leave *n after it.
+  
+private:
+  bool value(Value *out, int depth);
+  bool object(Value *out, int depth);
+  bool vector(Value *out, int depth);
+  bool string();
+  bool scalar(Value *out);
+  bool fail(const std::string &msg) { return json::fail(_s, _index, _n, msg); }
+  
+  char peek() const { return _n < _index.size() ? _s[_index[_n]] : 0; }
+  
+  std::string_view _s;
+  const std::vector<uint32_t> &_index;
+  B &_b;
+  size_t _n;
+  std::string _scratch;
+    // the string we just parsed.
+  
+};
+
+template<typename B>
+bool Parser<B>::value(Value *out, int depth) {
+
+  if (depth > 1024) {
+    return fail("too deep");
+  }
+  
+  switch (peek()) {
+  
+  case 0:
+    return fail("unexpected end");
+    
+  case '{':
+    return object(out, depth);
+    
+  case '[':
+    return vector(out, depth);
+    
+  case '"':
+    if (!string()) {
+      return false;
+    }
+    _b.string(_scratch, out);
+    return true;
+    
+  case '}': case ']': case ':': case ',':
+    return fail("invalid value");
+    
+  default:
+    return scalar(out);
+  }
+  
+}
+
+template<typename B>
+bool Parser<B>::object(Value *out, int depth) {
+
+  auto obj = _b.beginObject();
+  _n++;
+  if (peek() == '}') {
+    _n++;
+    _b.endObject(obj, out);
+    return true;
+  }
+  
+  while (true) {
+    if (peek() != '"') {
+      return fail("expected a key");
+    }
+    if (!string()) {
+      return false;
+    }
+    auto key = _b.key(_scratch);
+    if (peek() != ':') {
+      return fail("expected :");
+    }
+    _n++;
+    Value v;
+    if (!value(&v, depth + 1)) {
+      return false;
+    }
+    _b.member(obj, std::move(key), std::move(v));
+    auto c = peek();
+    _n++;
+    if (c == '}') {
+      break;
+    }
+    if (c != ',') {
+      _n--;
+      return fail("expected , or }");
+    }
+  }
+  
+  _b.endObject(obj, out);
+  return true;
+  
+}
+
+template<typename B>
+bool Parser<B>::vector(Value *out, int depth) {
+
+  auto vec = _b.beginVector();
+  _n++;
+  if (peek() == ']') {
+    _n++;
+    _b.endVector(vec, out);
+    return true;
+  }
+  
+  while (true) {
+    Value e;
+    if (!value(&e, depth + 1)) {
+      return false;
+    }
+    _b.element(vec, std::move(e));
+    auto c = peek();
+    _n++;
+    if (c == ']') {
+      break;
+    }
+    if (c != ',') {
+      _n--;
+      return fail("expected , or ]");
+    }
+  }
+  
+  _b.endVector(vec, out);
+  return true;
+  
+}
+
+template<typename B>
+bool Parser<B>::string() {
+
+  size_t i = _index[_n] + 1;
+  _scratch.clear();
+  auto err = unescape(_s, &i, &_scratch);
+  if (err) {
+    return fail(err);
+  }
+  _n++;
+  return true;
+  
+}
+
+template<typename B>
+bool Parser<B>::scalar(Value *out) {
+
+  size_t i = _index[_n];
+  
+  auto c = _s[i];
+  if (c == 't' && _s.substr(i, 4) == "true") {
+    _b.boolean(true, out);
+    i += 4;
+  }
+  else if (c == 'f' && _s.substr(i, 5) == "false") {
+    _b.boolean(false, out);
+    i += 5;
+  }
+  else if (c == 'n' && _s.substr(i, 4) == "null") {
+    _b.null(out);
+    i += 4;
+  }
+  else {
+    Number num;
+    auto err = number(_s, &i, &num);
+    if (err) {
+      return fail(err);
+    }
+    _b.number(num, out);
+  }
+  
+  // the scalar has to finish where the next thing starts.
+  if (i < _s.size()) {
+    auto e = _s[i];
+    if (e != ' ' && e != '\t' && e != '\n' && e != '\r' && e != ',' && e != '}' && e != ']' && e != ':' && e != '"') {
+      return fail("invalid value");
+    }
+  }
+  _n++;
+  return true;
+  
+}
+
+
+} // json
+
+} // vops
+
+#endif // H_dictjson
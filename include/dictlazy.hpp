@@ -0,0 +1,111 @@
+/*
+  dictlazy.hpp
+  
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+    
+  A lazily parsed document.
+    
+  Dict::parseLazy() only runs the first stage of the SIMD parser over the
+  JSON, which finds where everything is. Nothing is made until you walk into 
+  it with the getters, find_pointer or the monad, and then only the bit you
+  are looking at is parsed. Everything you walk past is just skipped.
+  
+  Since the parts you don't look at are never parsed, they aren't checked
+  either past the strings and the brackets matching up.
+  
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+ 
+  https://github.com/visualopsholdings/dict
+*/
+
+#ifndef H_dictlazy
+#define H_dictlazy
+
+#include "dict.hpp"
+
+#include <cstdint>
+
+namespace vops {
+
+class DictLazy {
+
+public:
+  class Node {
+  
+    // A position in the document. It borrows the DictLazy so it's only good 
+    // while that is.
+    //
+    // It has the same getters as Dict, and the same monad as Result.
+    
+  public:
+    std::optional<std::string> getString() const;
+    std::optional<long long> getNum() const;
+    std::optional<bool> getBool() const;
+    std::optional<std::string> getFirstKey() const;
+      // the value of this node, or nullopt if it's not that type.
+      
+    Node object(std::string_view key) const;
+    Node vector(int index) const;
+    std::string string() const;
+    bool boolean() const;
+    long long num() const;
+    int size() const;
+    std::optional<std::string> error() const;
+    std::optional<int> errori() const;
+      // all exactly like Result.
+      
+    bool has_value() const { return _lazy != nullptr; }
+    
+    std::optional<DictG> toG() const;
+      // parse this node into a DictG.
+      
+  private:
+    friend class DictLazy;
+    
+    Node(const DictLazy *lazy, size_t n): _lazy(lazy), _n(n) {}
+    Node(const Node &prev, size_t n, std::string_view key);
+    Node(const Node &prev, const std::string &err);
+    
+    char type() const;
+    
+    const DictLazy *_lazy;
+    size_t _n;
+    std::string _path;
+    std::string _err;
+    
+  };
+  
+  Node root() const { return Node(this, 0); }
+    // the top of the document.
+    
+  std::optional<DictG> toG() const { return root().toG(); }
+    // parse the whole thing.
+    
+  std::optional<Node> find_pointer(const std::string &path) const;
+  std::optional<Node> find_pointer(const Dict::Pointer &path) const;
+    // just like Dict::find_pointer.
+    
+private:
+  friend class Dict;
+  
+  DictLazy() {}
+  
+  char at(size_t n) const { return _json[_index[n]]; }
+  size_t next(size_t n) const;
+  std::optional<size_t> member(size_t n, std::string_view key) const;
+  std::optional<size_t> element(size_t n, size_t index) const;
+  bool keyIs(size_t n, std::string_view key) const;
+  std::optional<std::string> decode(size_t n) const;
+  
+  std::string _json;
+  std::vector<uint32_t> _index;
+    // where everything is.
+  std::vector<uint32_t> _ends;
+    // for the start of objects and vectors, where in _index they end.
+  
+};
+
+} // vops
+
+#endif // H_dictlazy
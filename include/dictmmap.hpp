@@ -0,0 +1,52 @@
+/*
+  dictmmap.hpp
+  
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+    
+  A file mapped into memory.
+  
+  Big files are mapped so they can be parsed straight out of the pages, small ones
+  (or if it can't be mapped) are just read into a string.
+    
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+ 
+  https://github.com/visualopsholdings/dict
+*/
+
+#ifndef H_dictmmap
+#define H_dictmmap
+
+#include <string>
+#include <string_view>
+#include <optional>
+
+namespace vops {
+
+class MappedFile {
+
+public:
+  MappedFile(const std::string &fn, size_t threshold);
+    // map fn if it's at least threshold bytes.
+    
+  ~MappedFile();
+  
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+  
+  std::optional<std::string_view> data() const;
+    // what's in the file, or nullopt if it couldn't be read.
+    
+  bool mapped() const { return _map != nullptr; }
+    // was it actually mapped?
+    
+private:
+  void *_map = nullptr;
+  size_t _size = 0;
+  std::optional<std::string> _buf;
+  
+};
+
+} // vops
+
+#endif // H_dictmmap
@@ -0,0 +1,97 @@
+/*
+  dictp.hpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+
+  A persistent dictionary.
+
+  This is an immutable version of DictG where the objects and vectors
+  are shared between versions. Setting something only makes new nodes
+  along the path to it, everything else is shared with the old version so
+  keeping lots of versions around only costs what was changed.
+  
+  The keys are all interned so lots of objects with the same keys only
+  have one copy of each key, and it goes when nothing uses it anymore. Numbers, bools and nulls are kept right in the
+  node so the whole thing is about half the size of the DictG.
+
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+
+  https://github.com/visualopsholdings/dict
+*/
+
+#ifndef H_dictp
+#define H_dictp
+
+#include "dict.hpp"
+#include "dictsymbols.hpp"
+
+#include <memory>
+#include <variant>
+
+namespace vops {
+
+class DictP {
+
+public:
+  typedef std::vector<std::pair<Symbol, DictP>> Object;
+  typedef std::vector<DictP> Vector;
+
+  DictP() {}
+    // null.
+
+  explicit DictP(const DictG &g);
+  explicit DictP(Object o);
+  explicit DictP(Vector v);
+    // make a persistent version of these.
+
+  DictG toG() const;
+    // back to a normal DictG.
+
+  static std::optional<DictP> parseString(const std::string &s, const std::string &format=".json");
+    // parse and intern all the keys. JSON is parsed straight into a DictP,
+    // anything else is parsed into a DictG first.
+    
+  static std::optional<DictP> parseFile(const std::string &fn);
+    // a JSON file is parsed straight into a DictP too. Anything else, or one that
+    // includes other files, is parsed into a DictG first.
+
+  const Object *getObject() const;
+  const Vector *getVector() const;
+    // borrow what's in this node, or null if it's not that kind of node.
+    
+  std::optional<DictG> getScalar() const;
+    // a copy of what's in this node if it's not an object or a vector.
+
+  static std::optional<DictP> find_pointer(const DictP &p, const std::string &path);
+  static std::optional<DictP> find_pointer(const DictP &p, const Dict::Pointer &path);
+    // just like Dict::find_pointer, but nothing is copied.
+
+  static std::optional<DictP> set_at_pointer(const DictP &p, const std::string &path, const DictP &value);
+  static std::optional<DictP> set_at_pointer(const DictP &p, const Dict::Pointer &path, const DictP &value);
+    // just like Dict::set_at_pointer, p is never changed and the new version
+    // shares everything that wasn't on the path with it.
+
+  static bool same(const DictP &a, const DictP &b);
+    // true if these are actually the same node (not just equal). Numbers,
+    // bools and nulls are the same if they are equal.
+
+private:
+  friend class DictPBuilder;
+  
+  struct Node;
+    // a string, object or vector.
+  
+  const Node *node() const;
+  
+  static std::optional<DictP> parseJSON(std::string_view s, bool *includes);
+  
+  static std::optional<DictP> setPath(const DictP &p, Dict::Pointer::const_iterator i, Dict::Pointer::const_iterator end, const DictP &value);
+
+  std::variant<std::monostate, bool, int64_t, double, std::shared_ptr<const Node>> _value;
+
+};
+
+} // vops
+
+#endif // H_dictp
@@ -0,0 +1,65 @@
+/*
+  dictpool.hpp
+  
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+    
+  A simple pool of worker threads.
+    
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+ 
+  https://github.com/visualopsholdings/dict
+*/
+
+#ifndef H_dictpool
+#define H_dictpool
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <deque>
+#include <vector>
+#include <functional>
+#include <memory>
+
+namespace vops {
+
+class DictPool {
+
+public:
+  DictPool(int threads);
+    // start this many threads. 0 means one for each core.
+    
+  ~DictPool();
+    // finish everything that was submitted and stop.
+    
+  template<typename F>
+  auto submit(F f) -> std::future<decltype(f())> {
+    auto task = std::make_shared<std::packaged_task<decltype(f())()>>(std::move(f));
+    auto future = task->get_future();
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _queue.push_back([task]() { (*task)(); });
+    }
+    _cond.notify_one();
+    return future;
+  }
+    // run f on one of the threads.
+    
+  int size() const { return _threads.size(); }
+  
+private:
+  void worker();
+  
+  std::vector<std::thread> _threads;
+  std::mutex _mutex;
+  std::condition_variable _cond;
+  std::deque<std::function<void ()>> _queue;
+  bool _stop = false;
+  
+};
+
+} // vops
+
+#endif // H_dictpool
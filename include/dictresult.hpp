@@ -20,6 +20,11 @@
 
 #include <optional>
 #include <string>
+#include <string_view>
+#include <memory>
+#include <concepts>
+#include <functional>
+#include <span>
 #include <rfl.hpp>
 
 namespace vops {
@@ -88,6 +93,57 @@ private:
   
 };
 
+class ResultRef {
+  
+  // The same monad as Result, except rather than copying the current
+  // node at every step we hold onto the root and just walk a pointer
+  // down it. Only the terminal calls (string(), object() etc) make a copy.
+  
+public:
+  ResultRef(const DictG &g);
+    // borrow g. It must outlive this and any result made from it.
+    
+  ResultRef(DictG &&g);
+    // take ownership of a temporary.
+    
+  template<typename T> requires std::same_as<std::remove_cvref_t<T>, std::optional<DictG>>
+  ResultRef(T &&g): ResultRef(share(std::forward<T>(g))) {}
+    // an optional is borrowed if it's an lvalue, owned if it's a temporary
+    // and an error if it's empty.
+    
+  ResultRef(std::shared_ptr<const DictG> root);
+    // share ownership of root.
+  
+  std::string string();
+  bool boolean();
+  long long num();
+  ResultRef object(const std::string &key);
+  DictO object();
+  ResultRef vector(int index);
+  DictV vector();
+  int size();
+  std::optional<std::string> error();
+  std::optional<int> errori();
+    // all exactly like Result.
+    
+  bool has_value() const { return _node != nullptr; }
+  const DictG *get() const { return _node; }
+    // the current node, borrowed from the root. null if we are in error.
+    
+private:
+  static std::shared_ptr<const DictG> share(const std::optional<DictG> &g);
+  static std::shared_ptr<const DictG> share(std::optional<DictG> &&g);
+  
+  ResultRef(const ResultRef &prev, const DictG *node, const std::string &path);
+  ResultRef(const ResultRef &prev, const std::string &err);
+
+  std::shared_ptr<const DictG> _root;
+  const DictG *_node;
+  std::string _path;
+  std::string _err;
+  
+};
+
 };
 
 #endif // H_dictresult
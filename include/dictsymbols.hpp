@@ -0,0 +1,114 @@
+/*
+  dictsymbols.hpp
+  
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+    
+  Interned keys.
+    
+  When you have lots of objects that all use the same keys there only
+  needs to be one copy of each key. A Symbol is just a pointer to that copy
+  so it's small and comparing 2 of them is just comparing the pointers.
+  
+  Each key is counted, and when the last Symbol for it goes away so does the
+  key, so parsing lots of different keys doesn't keep them all around.
+
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+ 
+  https://github.com/visualopsholdings/dict
+*/
+
+#ifndef H_dictsymbols
+#define H_dictsymbols
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <memory>
+#include <atomic>
+#include <optional>
+#include <mutex>
+
+namespace vops {
+
+class Symbols;
+
+class Symbol {
+
+public:
+  Symbol(std::string_view s);
+  Symbol(const char *s): Symbol(std::string_view(s)) {}
+  Symbol(const std::string &s): Symbol(std::string_view(s)) {}
+    // intern s in the global symbols.
+    
+  Symbol(const Symbol &other);
+  Symbol(Symbol &&other) noexcept: _e(other._e) { other._e = nullptr; }
+  Symbol &operator=(const Symbol &other);
+  Symbol &operator=(Symbol &&other) noexcept;
+  ~Symbol();
+    // counted, so the key goes when the last one does.
+    
+  const std::string &str() const;
+  operator const std::string &() const { return str(); }
+  
+  bool operator==(const Symbol &other) const { return _e == other._e; }
+  bool operator==(std::string_view s) const { return str() == s; }
+  bool operator==(const std::string &s) const { return str() == s; }
+  bool operator==(const char *s) const { return str() == s; }
+  
+private:
+  friend class Symbols;
+  
+  struct Entry;
+  
+  explicit Symbol(Entry *e): _e(e) {}
+    // already counted.
+  
+  Entry *_e;
+  
+};
+
+struct Symbol::Entry {
+  std::string s;
+  std::atomic<size_t> refs;
+  Symbols *symbols;
+};
+
+inline const std::string &Symbol::str() const { return _e->s; }
+
+class Symbols {
+
+public:
+  Symbols() {}
+  Symbols(const Symbols &) = delete;
+  Symbols &operator=(const Symbols &) = delete;
+    // the symbols have to outlive all of the Symbols made from them.
+    
+  Symbol intern(std::string_view s);
+    // the symbol for s, adding it if it's not there.
+    
+  std::optional<Symbol> find(std::string_view s) const;
+    // the symbol for s, if there is one. If there isn't nothing
+    // is using that key.
+    
+  size_t size() const;
+  size_t bytes() const;
+    // how many symbols there are and roughly how much memory they take.
+    
+  static Symbols &global();
+    // the symbols used unless you say otherwise.
+    
+private:
+  friend class Symbol;
+  
+  void release(Symbol::Entry *e);
+  
+  mutable std::mutex _mutex;
+  std::unordered_map<std::string_view, std::unique_ptr<Symbol::Entry>> _symbols;
+    // the key is the string in the entry.
+  
+};
+
+} // vops
+
+#endif // H_dictsymbols
@@ -0,0 +1,149 @@
+/*
+  dicttape.hpp
+  
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+    
+  A read only document on a tape.
+    
+  A DictG is a tree with an allocation for every node. A DictTape is the 
+  same document in one contiguous vector of entries with all of the strings
+  in another one, so it's 2 allocations and walking it is walking memory in
+  order. Objects and vectors know where they end so you can skip over them.
+  
+  Make one with Dict::parseTape(), and only turn it into a DictG (toG())
+  if you need to.
+
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+ 
+  https://github.com/visualopsholdings/dict
+*/
+
+#ifndef H_dicttape
+#define H_dicttape
+
+#include "dict.hpp"
+
+#include <cstdint>
+
+namespace vops {
+
+class DictTape {
+
+public:
+  enum class Type : uint8_t { Null, Bool, Num, Double, String, Object, Vector };
+  
+  class Node {
+  
+    // A position on the tape. It borrows the tape so it's only good while
+    // the tape is.
+    //
+    // It has the same getters as Dict, and the same monad as Result.
+    
+  public:
+    Type type() const;
+    
+    std::optional<std::string_view> getStringView() const;
+    std::optional<long long> getNum() const;
+    std::optional<bool> getBool() const;
+    std::optional<std::string_view> getFirstKey() const;
+      // the value of this node, or nullopt if it's not that type.
+      
+    Node object(std::string_view key) const;
+    Node vector(int index) const;
+    std::string string() const;
+    bool boolean() const;
+    long long num() const;
+    int size() const;
+    std::optional<std::string> error() const;
+    std::optional<int> errori() const;
+      // all exactly like Result.
+      
+    bool has_value() const { return _tape != nullptr; }
+    
+    DictG toG() const;
+      // a copy of this node as a DictG.
+      
+    class const_iterator {
+    public:
+      Node operator*() const { return Node(_tape, _object ? _i + 1 : _i); }
+      std::string_view key() const { return _object ? _tape->str(_i) : std::string_view(); }
+        // the key if we are going through an object.
+      const_iterator &operator++() { _i = _tape->next(_object ? _i + 1 : _i); return *this; }
+      bool operator==(const const_iterator &other) const { return _i == other._i; }
+      bool operator!=(const const_iterator &other) const { return _i != other._i; }
+    private:
+      friend class Node;
+      const_iterator(const DictTape *tape, size_t i, bool object): _tape(tape), _i(i), _object(object) {}
+      const DictTape *_tape;
+      size_t _i;
+      bool _object;
+    };
+    
+    const_iterator begin() const;
+    const_iterator end() const;
+      // go through the things in an object or vector, this is how to walk
+      // a big vector since vector(i) has to skip everything before i.
+      
+  private:
+    friend class DictTape;
+    
+    Node(const DictTape *tape, size_t i): _tape(tape), _i(i) {}
+    Node(const Node &prev, size_t i, std::string_view key);
+    Node(const Node &prev, const std::string &err);
+    
+    const DictTape *_tape;
+    size_t _i;
+    std::string _path;
+    std::string _err;
+    
+  };
+  
+  Node root() const { return Node(this, 0); }
+    // the top of the document.
+    
+  DictG toG() const { return root().toG(); }
+    // convert the whole thing to a DictG.
+    
+  std::optional<Node> find_pointer(const std::string &path) const;
+  std::optional<Node> find_pointer(const Dict::Pointer &path) const;
+    // just like Dict::find_pointer.
+    
+  size_t entries() const { return _tape.size(); }
+  size_t bytes() const;
+    // how big the tape is.
+    
+private:
+  friend class Dict;
+  friend class TapeBuilder;
+  
+  struct Entry {
+    Type type;
+    uint32_t len;
+      // strings: the length. objects and vectors: how many things are in them.
+    union {
+      int64_t num;
+      double d;
+      uint64_t off;
+        // strings: where they are in _strings. objects and vectors: the entry
+        // after the end.
+    };
+  };
+  
+  DictTape() {}
+  
+  size_t next(size_t i) const;
+  std::string_view str(size_t i) const;
+  std::optional<size_t> member(size_t i, std::string_view key) const;
+  std::optional<size_t> element(size_t i, size_t index) const;
+  
+  std::vector<Entry> _tape;
+    // objects are the object, then key value pairs, where the key is a string.
+    // vectors are the vector, then the elements.
+  std::string _strings;
+  
+};
+
+} // vops
+
+#endif // H_dicttape
@@ -0,0 +1,87 @@
+/*
+  dictwatcher.hpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+
+  Keep a parsed file up to date.
+
+  The file and everything it includes are watched (with inotify on Linux,
+  everywhere else it just looks every second) and when something changes
+  the document is reloaded with DictIncludes, so only what changed is parsed
+  again. An include that isn't there is watched for too, and put in when it
+  turns up.
+
+  The new document is swapped in atomically, so anyone calling get() just gets
+  whichever version was there, and can keep using it for as long as they like.
+  If a change doesn't parse, you keep the last version that did.
+
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+
+  https://github.com/visualopsholdings/dict
+*/
+
+#ifndef H_dictwatcher
+#define H_dictwatcher
+
+#include "dictincludes.hpp"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <functional>
+#include <map>
+#include <set>
+#include <mutex>
+#include <condition_variable>
+
+namespace vops {
+
+class DictWatcher {
+
+public:
+  typedef std::function<void (std::shared_ptr<const DictG>)> Changed;
+
+  DictWatcher(const std::string &fn, Changed changed=nullptr, bool silentinclude=false);
+    // parse the file and start watching it. If you pass "changed", that is called
+    // (on the watching thread) with each new version.
+
+  ~DictWatcher();
+    // stop watching.
+
+  std::shared_ptr<const DictG> get() const;
+    // the latest version, or null if it has never parsed.
+
+  int version() const { return _version; }
+    // goes up by one for each new version.
+
+private:
+  void run();
+  void reload();
+  void watch();
+  std::optional<std::string> relevant(int wd, const char *name);
+
+  DictIncludes _includes;
+  Changed _changed;
+  mutable std::mutex _docMutex;
+  std::shared_ptr<const DictG> _doc;
+    // not std::atomic<std::shared_ptr> since libc++ doesn't have it.
+  std::atomic<int> _version = 0;
+  std::thread _thread;
+
+  // inotify.
+  int _fd = -1;
+  int _stopfd = -1;
+  std::map<int, std::string> _dirs;
+  std::set<std::string> _pending;
+
+  // polling.
+  std::mutex _mutex;
+  std::condition_variable _cond;
+  bool _stop = false;
+
+};
+
+} // vops
+
+#endif // H_dictwatcher
@@ -10,11 +10,15 @@
 */
 
 #include "dict.hpp"
+#include "dictincludes.hpp"
+#include "dictmmap.hpp"
+#include "dictcodec.hpp"
 
 #include <rfl.hpp>
-#include <rfl/json.hpp>
-#include <rfl/yaml.hpp>
 #include <boost/log/trivial.hpp>
+#include <atomic>
+#include <algorithm>
+#include <fstream>
 
 using namespace vops;
 namespace fs = std::filesystem;
@@ -25,7 +29,7 @@ std::optional<std::string> Dict::getString(std::optional<DictO> obj, const std::
     return std::nullopt;
   }
   
-  auto prop = obj->get(name);
+  auto prop = getGenericPtr(&*obj, name);
   if (!prop) {
     return std::nullopt;
   }
@@ -54,7 +58,7 @@ std::optional<long long> Dict::getNum(std::optional<DictO> obj, const std::strin
     return std::nullopt;
   }
   
-  auto prop = obj->get(name);
+  auto prop = getGenericPtr(&*obj, name);
   if (!prop) {
     return std::nullopt;
   }
@@ -84,7 +88,7 @@ std::optional<bool> Dict::getBool(std::optional<DictO> obj, const std::string &n
     return std::nullopt;
   }
   
-  auto prop = obj->get(name);
+  auto prop = getGenericPtr(&*obj, name);
   if (!prop) {
     return std::nullopt;
   }
@@ -113,7 +117,7 @@ std::optional<DictO> Dict::getObject(std::optional<DictO> obj, const std::string
     return std::nullopt;
   }
   
-  auto prop = obj->get(name);
+  auto prop = getGenericPtr(&*obj, name);
   if (!prop) {
     return std::nullopt;
   }
@@ -142,7 +146,7 @@ std::optional<DictG> Dict::getGeneric(std::optional<DictO> obj, const std::strin
     return std::nullopt;
   }
   
-  auto prop = obj->get(name);
+  auto prop = getGenericPtr(&*obj, name);
   if (!prop) {
     return std::nullopt;
   }
@@ -171,7 +175,7 @@ std::optional<DictV> Dict::getVector(std::optional<DictO> obj, const std::string
     return std::nullopt;
   }
   
-  auto prop = obj->get(name);
+  auto prop = getGenericPtr(&*obj, name);
   if (!prop) {
     return std::nullopt;
   }
@@ -337,161 +341,397 @@ std::optional<bool> Dict::getBool(rfl::Result<DictG> result) {
   
 }
 
-std::string Dict::toString(const DictG &g, bool pretty, const std::string &format) {
+const DictO *Dict::getObjectPtr(const DictG &obj) {
 
-  if (format == ".json") {
-    if (pretty) {
-      return rfl::json::write(g, rfl::json::pretty);
-    }
-    return rfl::json::write(g);
+  return std::get_if<DictO>(&obj.variant());
+  
+}
+
+const DictV *Dict::getVectorPtr(const DictG &obj) {
+
+  return std::get_if<DictV>(&obj.variant());
+  
+}
+
+std::optional<std::string_view> Dict::getStringView(const DictG &obj) {
+
+  auto str = std::get_if<std::string>(&obj.variant());
+  if (!str) {
+    return std::nullopt;
   }
+  return *str;
   
-  if (format == ".yml") {
-    return rfl::yaml::write(g);
+}
+
+const DictG *Dict::getGenericPtr(const DictO *obj, std::string_view name) {
+
+  if (!obj) {
+    return nullptr;
+  }
+  
+  for (auto &i: *obj) {
+    if (i.first == name) {
+      return &i.second;
+    }
   }
+  return nullptr;
+  
+}
 
-  BOOST_LOG_TRIVIAL(error) << "invalid format " << format;
-  return "???";
+void Dict::Index::build() const {
+
+  _index.clear();
+  _index.reserve(_obj->size());
+  size_t n = 0;
+  for (auto &e: *_obj) {
+    // emplace keeps the first one if there are duplicates, same as the scan.
+    _index.emplace(e.first, n++);
+  }
+  _stale.store(false, std::memory_order_relaxed);
+  _indexed.store(n, std::memory_order_release);
 
 }
 
-template<typename T>
-std::optional<DictG> Dict::parse(T &s, const std::string &format) {
+std::optional<size_t> Dict::Index::scan(std::string_view key) const {
 
-  if (format == ".json") {
-    auto g = rfl::json::read<DictG>(s);
-    if (g) {
-      return *g;
+  size_t n = 0;
+  for (auto &e: *_obj) {
+    if (e.first == key) {
+      return n;
     }
+    n++;
   }
-  else if (format == ".yml") {
-    auto g = rfl::yaml::read<DictG>(s);
-    if (g) {
-      return *g;
+  return std::nullopt;
+
+}
+
+std::optional<size_t> Dict::Index::find(std::string_view key) const {
+
+  if (_obj->size() <= _threshold) {
+    return scan(key);
+  }
+
+  // once it's built, lots of threads can read it at once without locking.
+  if (_stale.load(std::memory_order_acquire) || _indexed.load(std::memory_order_acquire) != _obj->size()) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto indexed = _indexed.load(std::memory_order_relaxed);
+    // if things were just added on the end index those, if it got smaller
+    // start again.
+    if (_stale.load(std::memory_order_relaxed) || indexed > _obj->size()) {
+      build();
+    }
+    else if (indexed < _obj->size()) {
+      for (auto i = std::next(_obj->begin(), indexed); i != _obj->end(); i++) {
+        _index.emplace(i->first, indexed++);
+      }
+      _indexed.store(indexed, std::memory_order_release);
     }
   }
-  else {
-    BOOST_LOG_TRIVIAL(error) << "invalid format " << format;
+
+  // the same size as when we built it, so a miss really is a miss.
+  auto found = _index.find(key);
+  if (found == _index.end()) {
     return std::nullopt;
   }
+  if (std::next(_obj->begin(), found->second)->first == key) {
+    return found->second;
+  }
   
-  BOOST_LOG_TRIVIAL(error) << "could not parse std::string to " << format;
-  return std::nullopt;
+  // it was moved without telling us (with changed()), so look for it.
+  return scan(key);
 
 }
 
-std::optional<DictG> Dict::parseString(const std::string &s, const std::string &format) {
-  return parse(s, format);
+const DictG *Dict::Index::get(std::string_view key) const {
+
+  auto pos = find(key);
+  if (!pos) {
+    return nullptr;
+  }
+  return &std::next(_obj->begin(), *pos)->second;
+
 }
 
-std::optional<DictG> Dict::parseStream(std::istream &s, const std::string &format) {
-  return parse(s, format);
+bool Dict::Index::set(const std::string &key, DictG &&value) {
+
+  if (!_mobj) {
+    BOOST_LOG_TRIVIAL(error) << "index is read only";
+    return false;
+  }
+
+  auto pos = find(key);
+  if (pos) {
+    std::next(_mobj->begin(), *pos)->second = std::move(value);
+    return true;
+  }
+
+  // the next find will pick this up.
+  _mobj->insert(key, std::move(value));
+  return true;
+
 }
 
-DictG resolveJSONIncludes(const fs::path &path, const DictG &g, bool silent) {
-
-  auto obj = vops::Dict::getObject(g);
-  if (obj) {
-    DictO newobj;
-    for (auto i: *obj) {
-      auto k = get<0>(i);
-//      BOOST_LOG_TRIVIAL(trace) << "processing " << k;
-      if (k == "...") {
-        auto s = vops::Dict::getString(get<1>(i));
-        if (!s) {
-          BOOST_LOG_TRIVIAL(error) << "include must be string path";
-          continue;
-        }
-        if ((*s)[0] != '<' || (*s)[s->size()-1] != '>') {
-          BOOST_LOG_TRIVIAL(error) << "invalid include filename format. Must have <> around it.";
-          continue;
-        }
-        auto p = path / (s->substr(1, s->size()-2));
-        if (!fs::exists(p)) {
-          if (!silent) {
-            BOOST_LOG_TRIVIAL(error) << "external include missing " << p.string();
-          }
-          continue;
-        }
-        auto d = vops::Dict::parseFile(p, silent);
-        if (d) {
-          auto o = Dict::getObject(*d);
-          if (!o) {
-            BOOST_LOG_TRIVIAL(error) << "only support including objects";
-            continue;
-          }
-          newobj = *o;
-        }
-      }
-      else {
-        newobj[k] = resolveJSONIncludes(path, get<1>(i), silent);
+bool Dict::Index::remove(const std::string &key) {
+
+  if (!_mobj) {
+    BOOST_LOG_TRIVIAL(error) << "index is read only";
+    return false;
+  }
+
+  if (!find(key)) {
+    BOOST_LOG_TRIVIAL(error) << key << " not found";
+    return false;
+  }
+
+  eraseKey(*_mobj, key);
+  changed();
+  return true;
+
+}
+
+void Dict::Index::changed() {
+
+  _stale.store(true, std::memory_order_release);
+  
+}
+
+const DictO *Dict::getObjectPtr(const DictO *obj, std::string_view name) {
+
+  auto prop = getGenericPtr(obj, name);
+  if (!prop) {
+    return nullptr;
+  }
+  return getObjectPtr(*prop);
+  
+}
+
+const DictV *Dict::getVectorPtr(const DictO *obj, std::string_view name) {
+
+  auto prop = getGenericPtr(obj, name);
+  if (!prop) {
+    return nullptr;
+  }
+  return getVectorPtr(*prop);
+  
+}
+
+std::optional<std::string_view> Dict::getStringView(const DictO *obj, std::string_view name) {
+
+  auto prop = getGenericPtr(obj, name);
+  if (!prop) {
+    return std::nullopt;
+  }
+  return getStringView(*prop);
+  
+}
+
+std::optional<long long> Dict::getNum(const DictO *obj, std::string_view name) {
+
+  auto prop = getGenericPtr(obj, name);
+  if (!prop) {
+    return std::nullopt;
+  }
+  return getNum(*prop);
+  
+}
+
+std::optional<bool> Dict::getBool(const DictO *obj, std::string_view name) {
+
+  auto prop = getGenericPtr(obj, name);
+  if (!prop) {
+    return std::nullopt;
+  }
+  return getBool(*prop);
+  
+}
+
+std::string Dict::toString(const DictG &g, bool pretty, const std::string &format) {
+
+  auto codec = DictCodec::get(format);
+  if (!codec) {
+    BOOST_LOG_TRIVIAL(error) << "invalid format " << format;
+    return "???";
+  }
+  auto s = codec->write(g, pretty);
+  if (!s) {
+    return "???";
+  }
+  return std::move(*s);
+
+}
+
+bool Dict::hasFormat(const std::string &format) {
+
+  return DictCodec::find(format).has_value();
+  
+}
+
+#ifdef DICT_SIMD_PARSER
+static std::atomic<Dict::JSONParser> jsonParser = Dict::JSONParser::Simd;
+#else
+static std::atomic<Dict::JSONParser> jsonParser = Dict::JSONParser::Rfl;
+#endif
+
+static std::atomic<size_t> mmapThreshold = 1024 * 1024;
+
+void Dict::setMmapThreshold(size_t bytes) {
+  mmapThreshold = bytes;
+}
+
+size_t Dict::getMmapThreshold() {
+  return mmapThreshold;
+}
+
+static std::optional<DictG> parseAs(std::string_view s, const std::string &format) {
+
+  if (format.empty()) {
+    // work it out.
+    for (auto &codec: DictCodec::sniffAll(s)) {
+      auto g = codec->parse(s);
+      if (g) {
+        return g;
       }
     }
-    return newobj;
+    BOOST_LOG_TRIVIAL(error) << "could not work out the format";
+    return std::nullopt;
   }
-  else {
-    auto v = vops::Dict::getVector(g);
-    if (v) {
-      DictV v2;
-      transform(v->begin(), v->end(), back_inserter(v2), [path, silent](auto e) {
-        return resolveJSONIncludes(path, e, silent);
-      });
-      return v2;
-    }
+  
+  auto codec = DictCodec::get(format);
+  if (!codec) {
+    BOOST_LOG_TRIVIAL(error) << "invalid format " << format;
+    return std::nullopt;
+  }
+  auto g = codec->parse(s);
+  if (!g) {
+    BOOST_LOG_TRIVIAL(error) << "could not parse std::string to " << format;
   }
   return g;
+  
 }
 
-std::optional<DictG> Dict::parseFile(const std::string &fn, bool silentinclude) {
+void Dict::setJSONParser(JSONParser parser) {
+  jsonParser = parser;
+}
 
-  fs::path p = fn;
+Dict::JSONParser Dict::getJSONParser() {
+  return jsonParser;
+}
 
-  if (p.extension() == ".json") {
-    auto g = rfl::json::load<DictG>(fn);
-    if (g) {
-      return resolveJSONIncludes(p.parent_path(), *g, silentinclude);
-    }
+template<typename T>
+std::optional<DictG> Dict::parse(T &s, const std::string &format) {
+
+  if constexpr (std::is_same_v<std::remove_cv_t<T>, std::string>) {
+    return parseAs(s, format);
+  }
+  else {
+    std::string str((std::istreambuf_iterator<char>(s)), std::istreambuf_iterator<char>());
+    return parseAs(str, format);
+  }
+
+}
+
+std::optional<DictG> Dict::parseString(const std::string &s, const std::string &format) {
+  return parse(s, format);
+}
+
+std::optional<DictG> Dict::parseStream(std::istream &s, const std::string &format) {
+  return parse(s, format);
+}
+
+std::optional<DictG> Dict::loadFile(const std::string &fn, size_t *hash) {
+
+  // an extension we don't know about is worked out from what's in it.
+  auto format = fs::path(fn).extension().string();
+  if (!DictCodec::find(format)) {
+    format = "";
   }
-  else if (p.extension() == ".yml") {
-    auto g = rfl::yaml::load<DictG>(fn);
+  
+  MappedFile f(fn, mmapThreshold);
+  auto s = f.data();
+  if (s) {
+    if (hash) {
+      *hash = std::hash<std::string_view>()(*s);
+    }
+    auto g = parseAs(*s, format);
     if (g) {
-      return *g;
+      return g;
     }
   }
-  else {
-    BOOST_LOG_TRIVIAL(error) << "invalid format " << p.extension();
-    return std::nullopt;
-  }
   
   BOOST_LOG_TRIVIAL(error) << "could not parse " << fn;
   return std::nullopt;
   
 }
 
+std::optional<DictG> Dict::parseFile(const std::string &fn, bool silentinclude, int threads) {
+
+  // nothing is kept after this, so the includes are moved into place.
+  return DictIncludes(silentinclude, threads).parse(fn, false);
+  
+}
+
+std::optional<DictG> Dict::parseFile(const std::string &fn, DictIncludes &includes) {
+
+  return includes.parseFile(fn);
+  
+}
+
 DictO Dict::removeKey(const DictO &m, const std::string &key) {
 
   DictO m2;
   
   // TBD: how do we do this with copy_if etc.
-  for (auto i: m) {
-    auto k = get<0>(i);
-    if (k != key) {
-      m2[k] = get<1>(i);
+  for (auto &i: m) {
+    if (i.first != key) {
+      m2.insert(i.first, i.second);
     }
   }
   
   return m2;
 }
 
+std::optional<size_t> Dict::eraseKey(DictO &obj, std::string_view key, DictG *removed) {
+
+  auto pos = std::find_if(obj.begin(), obj.end(), [key](auto &e) { return e.first == key; });
+  if (pos == obj.end()) {
+    return std::nullopt;
+  }
+  size_t n = pos - obj.begin();
+  
+  // there is no erase on an object, so move everything except pos
+  // into a new one.
+  DictO newobj;
+  for (auto i = obj.begin(); i != obj.end(); i++) {
+    if (i == pos) {
+      if (removed) {
+        *removed = std::move(i->second);
+      }
+    }
+    else {
+      newobj.insert(std::move(i->first), std::move(i->second));
+    }
+  }
+  obj = std::move(newobj);
+  return n;
+  
+}
+
+void Dict::insertKey(DictO &obj, size_t pos, const std::string &key, DictG &&value) {
+
+  // on the end and then rotated into place.
+  obj.insert(key, std::move(value));
+  std::rotate(std::next(obj.begin(), std::min(pos, obj.size() - 1)), std::prev(obj.end()), obj.end());
+  
+}
+
 DictO Dict::filterKeys(const DictO &m, const std::vector<std::string> &keys) {
 
   DictO m2;
 
   // TBD: how do we do this with copy_if etc.
-  for (auto i: m) {
-    auto k = get<0>(i);
-    if (find(keys.begin(), keys.end(), k) == keys.end()) {
-      m2[k] = get<1>(i);
+  for (auto &i: m) {
+    if (find(keys.begin(), keys.end(), i.first) == keys.end()) {
+      m2.insert(i.first, i.second);
     }
   }
   
@@ -0,0 +1,112 @@
+/*
+  dictbinary.cpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+
+  https://github.com/visualopsholdings/dict
+*/
+
+#include "dictbinary.hpp"
+#include "dict.hpp"
+
+#include <boost/log/trivial.hpp>
+
+#ifdef DICT_BSON
+#include <rfl/bson.hpp>
+#endif
+#ifdef DICT_MSGPACK
+#include <rfl/msgpack.hpp>
+#endif
+#ifdef DICT_CBOR
+#include <rfl/cbor.hpp>
+#endif
+
+using namespace vops;
+
+std::vector<std::string> binary::formats() {
+
+  std::vector<std::string> formats;
+#ifdef DICT_BSON
+  formats.push_back(".bson");
+#endif
+#ifdef DICT_MSGPACK
+  formats.push_back(".msgpack");
+#endif
+#ifdef DICT_CBOR
+  formats.push_back(".cbor");
+#endif
+  return formats;
+
+}
+
+template<typename R>
+static std::optional<DictG> result(R &&g, const std::string &format) {
+
+  if (!g) {
+    BOOST_LOG_TRIVIAL(error) << "could not parse " << format << " " << g.error().what();
+    return std::nullopt;
+  }
+  return std::move(*g);
+
+}
+
+template<typename B>
+static std::string bytes(const B &b) {
+
+  return std::string(b.begin(), b.end());
+
+}
+
+std::optional<DictG> binary::parse([[maybe_unused]] std::string_view s, const std::string &format) {
+
+#ifdef DICT_BSON
+  if (format == ".bson") {
+    return result(rfl::bson::read<DictG>(s.data(), s.size()), format);
+  }
+#endif
+#ifdef DICT_MSGPACK
+  if (format == ".msgpack") {
+    return result(rfl::msgpack::read<DictG>(s.data(), s.size()), format);
+  }
+#endif
+#ifdef DICT_CBOR
+  if (format == ".cbor") {
+    return result(rfl::cbor::read<DictG>(s.data(), s.size()), format);
+  }
+#endif
+
+  BOOST_LOG_TRIVIAL(error) << "not built with " << format;
+  return std::nullopt;
+
+}
+
+std::optional<std::string> binary::write([[maybe_unused]] const DictG &g, const std::string &format) {
+
+#ifdef DICT_BSON
+  if (format == ".bson") {
+    // a BSON document is always an object.
+    if (!Dict::getObjectPtr(g)) {
+      BOOST_LOG_TRIVIAL(error) << "only objects can be written as .bson";
+      return std::nullopt;
+    }
+    return bytes(rfl::bson::write(g));
+  }
+#endif
+#ifdef DICT_MSGPACK
+  if (format == ".msgpack") {
+    return bytes(rfl::msgpack::write(g));
+  }
+#endif
+#ifdef DICT_CBOR
+  if (format == ".cbor") {
+    return bytes(rfl::cbor::write(g));
+  }
+#endif
+
+  BOOST_LOG_TRIVIAL(error) << "not built with " << format;
+  return std::nullopt;
+
+}
@@ -0,0 +1,268 @@
+/*
+  dictcodec.cpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+
+  https://github.com/visualopsholdings/dict
+*/
+
+#include "dictcodec.hpp"
+#include "dictbinary.hpp"
+
+#include <rfl.hpp>
+#include <rfl/json.hpp>
+#include <rfl/yaml.hpp>
+#include <boost/log/trivial.hpp>
+#include <mutex>
+#include <cstring>
+
+using namespace vops;
+
+namespace {
+
+struct Table {
+  std::vector<std::shared_ptr<const DictCodec>> codecs;
+  std::unordered_map<std::string, DictCodec::Id> ids;
+};
+
+} // namespace
+
+static DictCodec::Id put(Table *t, DictCodec &&codec) {
+
+  auto c = std::make_shared<const DictCodec>(std::move(codec));
+  auto i = t->ids.find(c->format);
+  if (i != t->ids.end()) {
+    t->codecs[i->second] = c;
+    return i->second;
+  }
+  DictCodec::Id id = t->codecs.size();
+  t->codecs.push_back(c);
+  t->ids[c->format] = id;
+  return id;
+
+}
+
+static std::optional<unsigned char> firstChar(std::string_view s) {
+
+  size_t i = 0;
+  if (s.starts_with("\xEF\xBB\xBF")) {
+    i = 3;
+  }
+  for (; i<s.size(); i++) {
+    if (s[i] != ' ' && s[i] != '\t' && s[i] != '\r' && s[i] != '\n') {
+      return s[i];
+    }
+  }
+  return std::nullopt;
+
+}
+
+static bool sniffJSON(std::string_view s) {
+
+  auto c = firstChar(s);
+  // strchr finds the 0 on the end too.
+  return c && *c != 0 && (strchr("{[\"-tfn", *c) || isdigit(*c));
+
+}
+
+static bool sniffYAML(std::string_view s) {
+
+  // any text, but binary always has a 0 or a high bit near the start.
+  auto c = firstChar(s);
+  if (!c || *c < 0x20 || *c >= 0x7f) {
+    return false;
+  }
+  return s.substr(0, 1024).find('\0') == std::string_view::npos;
+
+}
+
+static bool sniffBSON(std::string_view s) {
+
+  // a little endian length that is exactly the size, and a 0 on the end.
+  if (s.size() < 5 || s.back() != 0) {
+    return false;
+  }
+  auto b = (const unsigned char *)s.data();
+  uint32_t len = b[0] | (b[1] << 8) | (b[2] << 16) | ((uint32_t)b[3] << 24);
+  return len == s.size();
+
+}
+
+static bool sniffMsgPack(std::string_view s) {
+
+  // a fixmap, fixarray, array 16/32 or map 16/32.
+  if (s.empty()) {
+    return false;
+  }
+  unsigned char c = s[0];
+  return (c >= 0x80 && c <= 0x9f) || (c >= 0xdc && c <= 0xdf);
+
+}
+
+static bool sniffCBOR(std::string_view s) {
+
+  // the self describe tag, or an array or a map.
+  if (s.starts_with("\xD9\xD9\xF7")) {
+    return true;
+  }
+  return !s.empty() && (unsigned char)s[0] >= 0x80 && (unsigned char)s[0] <= 0xbf;
+
+}
+
+static std::optional<std::string> streamed(const DictCodec::Stream &stream, const DictG &g, bool pretty) {
+
+  // our own writers only stream, so collect it all up.
+  std::string s;
+  char buffer[16384];
+  if (!stream(g, pretty, buffer, [&s](std::string_view chunk) { s += chunk; return true; })) {
+    return std::nullopt;
+  }
+  return s;
+
+}
+
+static std::shared_ptr<const Table> builtin() {
+
+  auto t = std::make_shared<Table>();
+
+  // the ones added last are sniffed first, so the text formats go in first
+  // since they are the least fussy.
+  put(t.get(), {
+    .format = ".yml",
+    .parse = [](std::string_view s) -> std::optional<DictG> {
+      auto g = rfl::yaml::read<DictG>(std::string(s));
+      if (!g) {
+        return std::nullopt;
+      }
+      return std::move(*g);
+    },
+    .write = [](const DictG &g, bool) -> std::optional<std::string> {
+      return rfl::yaml::write(g);
+    },
+    .stream = codec::writeYAML,
+    .sniff = sniffYAML
+  });
+
+  put(t.get(), {
+    .format = ".json",
+    .parse = [](std::string_view s) -> std::optional<DictG> {
+      if (Dict::getJSONParser() == Dict::JSONParser::Simd) {
+        return Dict::parseSimd(s);
+      }
+      auto g = rfl::json::read<DictG>(s);
+      if (!g) {
+        return std::nullopt;
+      }
+      return std::move(*g);
+    },
+    .write = [](const DictG &g, bool pretty) { return streamed(codec::writeJSON, g, pretty); },
+    .stream = codec::writeJSON,
+    .sniff = sniffJSON
+  });
+
+  // MessagePack and CBOR look alike, so MessagePack is tried first since
+  // it's more likely.
+  auto binaries = binary::formats();
+  for (auto i = binaries.rbegin(); i != binaries.rend(); i++) {
+    auto format = *i;
+    put(t.get(), {
+      .format = format,
+      .parse = [format](std::string_view s) { return binary::parse(s, format); },
+      .write = [format](const DictG &g, bool) { return binary::write(g, format); },
+      .stream = nullptr,
+      .sniff = format == ".bson" ? sniffBSON : format == ".msgpack" ? sniffMsgPack : sniffCBOR
+    });
+  }
+
+  return t;
+
+}
+
+// the table is never changed, adding a codec swaps in a new one. Readers only
+// hold the lock long enough to get whichever table is there.
+// (std::atomic<std::shared_ptr> isn't in libc++ yet.)
+static std::mutex tableMutex;
+static std::shared_ptr<const Table> theTable;
+
+static std::shared_ptr<const Table> table() {
+
+  std::lock_guard<std::mutex> lock(tableMutex);
+  if (!theTable) {
+    theTable = builtin();
+  }
+  return theTable;
+
+}
+
+DictCodec::Id DictCodec::add(DictCodec codec) {
+
+  static std::mutex mutex;
+  std::lock_guard<std::mutex> lock(mutex);
+  auto t = std::make_shared<Table>(*table());
+  auto id = put(t.get(), std::move(codec));
+  {
+    std::lock_guard<std::mutex> lock(tableMutex);
+    theTable = t;
+  }
+  return id;
+
+}
+
+std::optional<DictCodec::Id> DictCodec::find(const std::string &format) {
+
+  auto t = table();
+  auto i = t->ids.find(format);
+  if (i == t->ids.end()) {
+    return std::nullopt;
+  }
+  return i->second;
+
+}
+
+std::shared_ptr<const DictCodec> DictCodec::get(Id id) {
+
+  auto t = table();
+  if (id < 0 || (size_t)id >= t->codecs.size()) {
+    return nullptr;
+  }
+  return t->codecs[id];
+
+}
+
+std::shared_ptr<const DictCodec> DictCodec::get(const std::string &format) {
+
+  auto t = table();
+  auto i = t->ids.find(format);
+  if (i == t->ids.end()) {
+    return nullptr;
+  }
+  return t->codecs[i->second];
+
+}
+
+std::vector<std::shared_ptr<const DictCodec>> DictCodec::sniffAll(std::string_view s) {
+
+  auto t = table();
+  std::vector<std::shared_ptr<const DictCodec>> found;
+  for (auto i = t->codecs.rbegin(); i != t->codecs.rend(); i++) {
+    if ((*i)->sniff && (*i)->sniff(s)) {
+      found.push_back(*i);
+    }
+  }
+  return found;
+
+}
+
+std::vector<std::string> DictCodec::formats() {
+
+  auto t = table();
+  std::vector<std::string> formats;
+  for (auto &c: t->codecs) {
+    formats.push_back(c->format);
+  }
+  return formats;
+
+}
@@ -0,0 +1,529 @@
+/*
+  dictincludes.cpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+
+  https://github.com/visualopsholdings/dict
+*/
+
+#include "dictincludes.hpp"
+#include "dictpool.hpp"
+
+#include <boost/log/trivial.hpp>
+#include <deque>
+#include <algorithm>
+#include <set>
+
+using namespace vops;
+namespace fs = std::filesystem;
+
+DictIncludes::File DictIncludes::load(const std::string &key, bool hash) {
+
+  File f;
+  std::error_code ec;
+  f.mtime = fs::last_write_time(key, ec);
+  f.doc = Dict::loadFile(key, hash ? &f.hash : nullptr);
+  f.state = File::State::Loaded;
+  return f;
+
+}
+
+static std::optional<std::string> includePath(const fs::path &dir, const DictG &g, bool silent, std::string *missing=nullptr) {
+
+  auto s = Dict::getStringView(g);
+  if (!s) {
+    BOOST_LOG_TRIVIAL(error) << "include must be string path";
+    return std::nullopt;
+  }
+  if (s->empty() || s->front() != '<' || s->back() != '>') {
+    BOOST_LOG_TRIVIAL(error) << "invalid include filename format. Must have <> around it.";
+    return std::nullopt;
+  }
+  auto p = dir / s->substr(1, s->size()-2);
+  if (!fs::exists(p)) {
+    if (!silent) {
+      BOOST_LOG_TRIVIAL(error) << "external include missing " << p.string();
+    }
+    if (missing) {
+      *missing = fs::weakly_canonical(p).string();
+    }
+    return std::nullopt;
+  }
+  return fs::weakly_canonical(p).string();
+
+}
+
+static void findIncludes(const fs::path &dir, const DictG &g, std::vector<std::string> *found) {
+
+  auto obj = Dict::getObjectPtr(g);
+  if (obj) {
+    for (auto &i: *obj) {
+      if (i.first == "...") {
+        // errors are logged when it's resolved.
+        auto p = includePath(dir, i.second, true);
+        if (p) {
+          found->push_back(*p);
+        }
+      }
+      else {
+        findIncludes(dir, i.second, found);
+      }
+    }
+    return;
+  }
+
+  auto v = Dict::getVectorPtr(g);
+  if (v) {
+    for (auto &e: *v) {
+      findIncludes(dir, e, found);
+    }
+  }
+
+}
+
+static bool isJSON(const std::string &fn) {
+  return fs::path(fn).extension() == ".json";
+}
+
+std::optional<DictG> DictIncludes::parseFile(const std::string &fn) {
+
+  return parse(fn, true);
+
+}
+
+std::optional<DictG> DictIncludes::parse(const std::string &fn, bool keep) {
+
+  _keep = keep;
+  _files.clear();
+
+  fs::path p = fn;
+  _root = fs::weakly_canonical(p).string();
+  auto &root = _files[_root];
+  root = load(_root, _keep);
+  // the root keeps the directory it was given as rather than where it really is.
+  root.dir = p.parent_path();
+  if (!root.doc) {
+    // it's kept so it can be reloaded when it's fixed.
+    return std::nullopt;
+  }
+
+  if (_threads != 1 && isJSON(_root)) {
+    loadIncludes();
+  }
+
+  auto &g = include(_root);
+  if (!_keep) {
+    return std::move(root.resolved);
+  }
+  prune();
+  return g;
+
+}
+
+void DictIncludes::loadIncludes() {
+
+  DictPool pool(_threads);
+  std::deque<std::pair<std::string, std::future<File>>> pending;
+  bool keep = _keep;
+
+  // as each file comes in, look for what that includes.
+  auto discover = [&](const File &f) {
+    std::vector<std::string> found;
+    findIncludes(f.dir, *f.doc, &found);
+    for (auto &key: found) {
+      if (_files.find(key) == _files.end()) {
+        _files[key];
+        pending.push_back({ key, pool.submit([key, keep]() { return load(key, keep); }) });
+      }
+    }
+  };
+
+  discover(_files[_root]);
+  while (!pending.empty()) {
+    auto p = std::move(pending.front());
+    pending.pop_front();
+    auto &f = _files[p.first];
+    f = p.second.get();
+    f.dir = fs::path(p.first).parent_path();
+    if (f.doc && isJSON(p.first)) {
+      discover(f);
+    }
+  }
+
+}
+
+const std::optional<DictG> &DictIncludes::include(const std::string &key) {
+
+  static const std::optional<DictG> none;
+
+  // the map is node based so this reference is still good after the
+  // recursive includes add to it.
+  auto &f = _files[key];
+  switch (f.state) {
+  case File::State::Resolved:
+    return f.resolved;
+
+  case File::State::Resolving:
+    BOOST_LOG_TRIVIAL(error) << "include cycle through " << key;
+    return none;
+
+  case File::State::Unloaded:
+    f = load(key, _keep);
+    f.dir = fs::path(key).parent_path();
+    break;
+
+  case File::State::Loaded:
+    break;
+    
+  case File::State::Stale:
+    f.state = File::State::Resolving;
+    if (splice(&f)) {
+      f.state = File::State::Resolved;
+      return f.resolved;
+    }
+    break;
+  }
+
+  f.state = File::State::Resolving;
+  f.includes.clear();
+  f.sites.clear();
+  if (f.doc) {
+    if (isJSON(key)) {
+      std::string path;
+      f.resolved = resolve(f.dir, _keep ? DictG(*f.doc) : std::move(*f.doc), &f, &path);
+    }
+    else {
+      f.resolved = _keep ? *f.doc : std::move(*f.doc);
+    }
+  }
+  else {
+    f.resolved = std::nullopt;
+  }
+  if (!_keep) {
+    f.doc = std::nullopt;
+  }
+  f.state = File::State::Resolved;
+  return f.resolved;
+
+}
+
+bool DictIncludes::splice(File *f) {
+
+  if (!f->doc || !f->resolved) {
+    return false;
+  }
+  
+  // the file itself is the same, so just do the places where it includes
+  // something that changed again.
+  std::vector<std::string> done;
+  for (auto &site: f->sites) {
+    if (_dirty.find(site.first) == _dirty.end()) {
+      continue;
+    }
+    // inside one we've already done.
+    auto inside = std::find_if(done.begin(), done.end(), [&site](auto &d) { 
+      return site.second.size() > d.size() && site.second.compare(0, d.size(), d) == 0 && site.second[d.size()] == '/'; 
+    });
+    if (inside != done.end()) {
+      continue;
+    }
+    Dict::Pointer p(site.second);
+    auto raw = Dict::find_pointer_ptr(*f->doc, p);
+    if (!raw) {
+      return false;
+    }
+    File scratch;
+    auto path = site.second;
+    auto g = resolve(f->dir, DictG(*raw), &scratch, &path);
+    if (site.second.empty()) {
+      f->resolved = std::move(g);
+    }
+    else if (!Dict::find_pointer_ptr(*f->resolved, p) || !Dict::set_at_pointer_in_place(*f->resolved, p, std::move(g))) {
+      // the include was thrown away by another include later on.
+      return false;
+    }
+    done.push_back(site.second);
+  }
+  return true;
+  
+}
+
+static void appendToken(std::string *path, const std::string &key) {
+
+  path->push_back('/');
+  for (auto c: key) {
+    if (c == '~') {
+      path->append("~0");
+    }
+    else if (c == '/') {
+      path->append("~1");
+    }
+    else {
+      path->push_back(c);
+    }
+  }
+  
+}
+
+DictG DictIncludes::resolve(const fs::path &dir, DictG &&g, File *f, std::string *path) {
+
+  auto obj = std::get_if<DictO>(&g.variant());
+  if (obj) {
+    auto len = path->size();
+    
+    if (std::find_if(obj->begin(), obj->end(), [](auto &i) { return i.first == "..."; }) == obj->end()) {
+      // nothing to splice in, so it's just what's in it.
+      for (auto &i: *obj) {
+        if (_keep) {
+          appendToken(path, i.first);
+        }
+        i.second = resolve(dir, std::move(i.second), f, path);
+        path->resize(len);
+      }
+      return std::move(g);
+    }
+    
+    // keys after an include replace the ones it brought in. The keys are in
+    // this object or the included one, and they both stay put.
+    DictO newobj;
+    std::unordered_map<std::string_view, size_t> keys;
+    auto start = f->sites.size();
+    for (auto &i: *obj) {
+      auto &k = get<0>(i);
+      if (k == "...") {
+        std::string missing;
+        auto p = includePath(dir, get<1>(i), _silent, &missing);
+        if (!p) {
+          if (!missing.empty()) {
+            // so it's put in when it turns up.
+            f->includes.push_back(missing);
+            if (_keep) {
+              f->sites.push_back({ missing, *path });
+            }
+          }
+          continue;
+        }
+        f->includes.push_back(*p);
+        if (_keep) {
+          f->sites.push_back({ *p, *path });
+        }
+        auto &d = include(*p);
+        if (d) {
+          auto o = Dict::getObjectPtr(*d);
+          if (!o) {
+            BOOST_LOG_TRIVIAL(error) << "only support including objects";
+            continue;
+          }
+          newobj = *o;
+          keys.clear();
+          size_t n = 0;
+          for (auto &e: *o) {
+            keys.emplace(e.first, n++);
+          }
+          if (_keep) {
+            // everything in this object before the include was just thrown away, so
+            // there is nothing to splice into there anymore.
+            f->sites.erase(f->sites.begin() + start, f->sites.end() - 1);
+          }
+        }
+      }
+      else {
+        if (_keep) {
+          appendToken(path, k);
+        }
+        auto value = resolve(dir, std::move(get<1>(i)), f, path);
+        auto found = keys.find(k);
+        if (found != keys.end()) {
+          std::next(newobj.begin(), found->second)->second = std::move(value);
+        }
+        else {
+          keys.emplace(k, newobj.size());
+          newobj.insert(k, std::move(value));
+        }
+        path->resize(len);
+      }
+    }
+    return newobj;
+  }
+
+  auto v = std::get_if<DictV>(&g.variant());
+  if (v) {
+    auto len = path->size();
+    for (size_t i=0; i<v->size(); i++) {
+      if (_keep) {
+        path->push_back('/');
+        path->append(std::to_string(i));
+      }
+      (*v)[i] = resolve(dir, std::move((*v)[i]), f, path);
+      path->resize(len);
+    }
+  }
+  return std::move(g);
+
+}
+
+const std::optional<DictG> &DictIncludes::reload(bool *changed) {
+
+  static const std::optional<DictG> none;
+
+  if (changed) {
+    *changed = false;
+  }
+  if (_root.empty()) {
+    BOOST_LOG_TRIVIAL(error) << "nothing to reload";
+    return none;
+  }
+  if (!_keep) {
+    BOOST_LOG_TRIVIAL(error) << "includes weren't kept";
+    return none;
+  }
+
+  // find what has actually changed, without touching anything until we
+  // know all of them parse.
+  std::vector<std::pair<std::string, File>> updates;
+  std::vector<std::pair<std::string, fs::file_time_type>> touched;
+  bool removed = false;
+  for (auto &i: _files) {
+    std::error_code ec;
+    auto mtime = fs::last_write_time(i.first, ec);
+    if (!ec && mtime == i.second.mtime) {
+      continue;
+    }
+    if (ec) {
+      // it's gone, the files that include it will say so.
+      updates.push_back({ i.first, File() });
+      updates.back().second.state = File::State::Loaded;
+      removed = true;
+      continue;
+    }
+    auto f = load(i.first, true);
+    if (!f.doc) {
+      return none;
+    }
+    if (f.hash == i.second.hash) {
+      touched.push_back({ i.first, f.mtime });
+      continue;
+    }
+    updates.push_back({ i.first, std::move(f) });
+  }
+  for (auto &m: _missing) {
+    if (!fs::exists(m)) {
+      continue;
+    }
+    auto f = load(m, true);
+    if (!f.doc) {
+      return none;
+    }
+    updates.push_back({ m, std::move(f) });
+  }
+  for (auto &t: touched) {
+    _files[t.first].mtime = t.second;
+  }
+
+  auto &root = _files[_root];
+  if (updates.empty()) {
+    if (!root.resolved) {
+      // it was released.
+      include(_root);
+    }
+    return root.resolved;
+  }
+  if (changed) {
+    *changed = true;
+  }
+
+  // everything that includes a file that changed has to be put back together.
+  _dirty.clear();
+  for (auto &u: updates) {
+    auto [i, added] = _files.try_emplace(u.first);
+    auto &f = i->second;
+    auto dir = added ? fs::path(u.first).parent_path() : f.dir;
+    f = std::move(u.second);
+    f.dir = dir;
+    _dirty.insert(u.first);
+  }
+  bool more = true;
+  while (more) {
+    more = false;
+    for (auto &i: _files) {
+      if (_dirty.find(i.first) != _dirty.end()) {
+        continue;
+      }
+      for (auto &inc: i.second.includes) {
+        if (_dirty.find(inc) != _dirty.end()) {
+          // when a file has gone, the files that included it have to be done
+          // from scratch so they forget about it.
+          i.second.state = removed ? File::State::Loaded : File::State::Stale;
+          _dirty.insert(i.first);
+          more = true;
+          break;
+        }
+      }
+    }
+  }
+
+  include(_root);
+  _dirty.clear();
+  prune();
+  return _files[_root].resolved;
+
+}
+
+std::optional<DictG> DictIncludes::release() {
+
+  auto f = _files.find(_root);
+  if (f == _files.end()) {
+    return std::nullopt;
+  }
+  // put back together from the files next time.
+  f->second.state = File::State::Loaded;
+  auto g = std::move(f->second.resolved);
+  f->second.resolved = std::nullopt;
+  return g;
+
+}
+
+void DictIncludes::invalidate(const std::string &fn) {
+
+  auto f = _files.find(fn);
+  if (f != _files.end()) {
+    f->second.mtime = fs::file_time_type::min();
+  }
+  
+}
+
+void DictIncludes::prune() {
+
+  // forget about anything that isn't included anymore, and remember the
+  // includes that aren't there (yet).
+  std::set<std::string> used;
+  _missing.clear();
+  std::vector<std::string> todo = { _root };
+  while (!todo.empty()) {
+    auto key = todo.back();
+    todo.pop_back();
+    if (key != _root && !fs::exists(key)) {
+      _missing.insert(key);
+      continue;
+    }
+    if (!used.insert(key).second) {
+      continue;
+    }
+    auto f = _files.find(key);
+    if (f != _files.end()) {
+      todo.insert(todo.end(), f->second.includes.begin(), f->second.includes.end());
+    }
+  }
+  for (auto i = _files.begin(); i != _files.end(); ) {
+    if (used.find(i->first) == used.end()) {
+      i = _files.erase(i);
+    }
+    else {
+      i++;
+    }
+  }
+
+}
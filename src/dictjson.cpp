@@ -0,0 +1,262 @@
+/*
+  dictjson.cpp
+  
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+  
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+ 
+  https://github.com/visualopsholdings/dict
+*/
+
+#include "dictjson.hpp"
+
+#include <charconv>
+#include <cstring>
+
+using namespace vops;
+
+void json::appendUTF8(std::string *out, unsigned cp) {
+
+  if (cp < 0x80) {
+    *out += char(cp);
+  }
+  else if (cp < 0x800) {
+    *out += char(0xC0 | (cp >> 6));
+    *out += char(0x80 | (cp & 0x3F));
+  }
+  else if (cp < 0x10000) {
+    *out += char(0xE0 | (cp >> 12));
+    *out += char(0x80 | ((cp >> 6) & 0x3F));
+    *out += char(0x80 | (cp & 0x3F));
+  }
+  else {
+    *out += char(0xF0 | (cp >> 18));
+    *out += char(0x80 | ((cp >> 12) & 0x3F));
+    *out += char(0x80 | ((cp >> 6) & 0x3F));
+    *out += char(0x80 | (cp & 0x3F));
+  }
+  
+}
+
+static bool hex4(std::string_view s, size_t i, unsigned *cp) {
+
+  if (i + 4 > s.size()) {
+    return false;
+  }
+  auto r = std::from_chars(s.data() + i, s.data() + i + 4, *cp, 16);
+  return r.ec == std::errc() && r.ptr == s.data() + i + 4;
+  
+}
+
+const char *json::unescape(std::string_view s, size_t *i, std::string *out) {
+
+  auto n = *i;
+  
+  while (true) {
+  
+    // copy everything up to the next thing we need to look at.
+    auto start = n;
+    n = findEscape(s, n);
+    out->append(s.data() + start, n - start);
+    
+    if (n >= s.size()) {
+      return "unterminated string";
+    }
+    if (s[n] == '"') {
+      *i = n + 1;
+      return nullptr;
+    }
+    if (s[n] != '\\') {
+      return "control character in string";
+    }
+    
+    n++;
+    if (n >= s.size()) {
+      return "unterminated string";
+    }
+    switch (s[n++]) {
+    case '"': *out += '"'; break;
+    case '\\': *out += '\\'; break;
+    case '/': *out += '/'; break;
+    case 'b': *out += '\b'; break;
+    case 'f': *out += '\f'; break;
+    case 'n': *out += '\n'; break;
+    case 'r': *out += '\r'; break;
+    case 't': *out += '\t'; break;
+    case 'u':
+      {
+        unsigned cp;
+        if (!hex4(s, n, &cp)) {
+          return "invalid \\u escape";
+        }
+        n += 4;
+        if (cp >= 0xD800 && cp < 0xDC00) {
+          unsigned lo;
+          if (n + 2 > s.size() || s[n] != '\\' || s[n+1] != 'u' || !hex4(s, n + 2, &lo) || lo < 0xDC00 || lo >= 0xE000) {
+            return "invalid surrogate pair";
+          }
+          n += 6;
+          cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+        }
+        else if (cp >= 0xDC00 && cp < 0xE000) {
+          return "invalid surrogate pair";
+        }
+        appendUTF8(out, cp);
+      }
+      break;
+    default:
+      return "invalid escape";
+    }
+  }
+  
+}
+
+const char *json::number(std::string_view s, size_t *i, Number *num) {
+
+  auto n = *i;
+  num->integer = true;
+  
+  auto digits = [&s, &n]() {
+    auto start = n;
+    while (n < s.size() && s[n] >= '0' && s[n] <= '9') {
+      n++;
+    }
+    return n - start;
+  };
+  
+  if (n < s.size() && s[n] == '-') {
+    n++;
+  }
+  if (n < s.size() && s[n] == '0') {
+    n++;
+  }
+  else if (digits() == 0) {
+    return "invalid value";
+  }
+  if (n < s.size() && s[n] == '.') {
+    num->integer = false;
+    n++;
+    if (digits() == 0) {
+      return "invalid number";
+    }
+  }
+  if (n < s.size() && (s[n] == 'e' || s[n] == 'E')) {
+    num->integer = false;
+    n++;
+    if (n < s.size() && (s[n] == '+' || s[n] == '-')) {
+      n++;
+    }
+    if (digits() == 0) {
+      return "invalid number";
+    }
+  }
+  
+  auto first = s.data() + *i;
+  auto last = s.data() + n;
+  *i = n;
+  if (num->integer) {
+    auto r = std::from_chars(first, last, num->num);
+    if (r.ec == std::errc()) {
+      return nullptr;
+    }
+    // too big, so it's a double.
+    num->integer = false;
+  }
+  
+  auto r = std::from_chars(first, last, num->d);
+  if (r.ec != std::errc()) {
+    return "invalid number";
+  }
+  return nullptr;
+  
+}
+
+bool json::validUTF8Scalar(std::string_view s) {
+
+  size_t i = 0;
+  while (i < s.size()) {
+  
+    // skip ASCII 8 at a time.
+    if (i + 8 <= s.size()) {
+      uint64_t w;
+      memcpy(&w, s.data() + i, 8);
+      if ((w & 0x8080808080808080ULL) == 0) {
+        i += 8;
+        continue;
+      }
+    }
+    
+    unsigned char c = s[i];
+    if (c < 0x80) {
+      i++;
+      continue;
+    }
+    
+    size_t len;
+    unsigned cp;
+    if ((c & 0xE0) == 0xC0) {
+      len = 2;
+      cp = c & 0x1F;
+    }
+    else if ((c & 0xF0) == 0xE0) {
+      len = 3;
+      cp = c & 0x0F;
+    }
+    else if ((c & 0xF8) == 0xF0) {
+      len = 4;
+      cp = c & 0x07;
+    }
+    else {
+      return false;
+    }
+    if (i + len > s.size()) {
+      return false;
+    }
+    for (size_t j=1; j<len; j++) {
+      unsigned char cc = s[i + j];
+      if ((cc & 0xC0) != 0x80) {
+        return false;
+      }
+      cp = (cp << 6) | (cc & 0x3F);
+    }
+    
+    // no overlong encodings, surrogates or anything too big.
+    if ((len == 2 && cp < 0x80) || (len == 3 && cp < 0x800) || (len == 4 && cp < 0x10000) ||
+        (cp >= 0xD800 && cp < 0xE000) || cp > 0x10FFFF) {
+      return false;
+    }
+    i += len;
+  }
+  return true;
+  
+}
+
+size_t json::findEscapeScalar(std::string_view s, size_t i) {
+
+  while (i < s.size() && s[i] != '"' && s[i] != '\\' && (unsigned char)s[i] >= 0x20) {
+    i++;
+  }
+  return i;
+  
+}
+
+std::string_view json::escaped(char c, char *buf) {
+
+  switch (c) {
+  case '"': return "\\\"";
+  case '\\': return "\\\\";
+  case '\b': return "\\b";
+  case '\f': return "\\f";
+  case '\n': return "\\n";
+  case '\r': return "\\r";
+  case '\t': return "\\t";
+  }
+  
+  static const char hex[] = "0123456789abcdef";
+  memcpy(buf, "\\u00", 4);
+  buf[4] = hex[((unsigned char)c >> 4) & 0xF];
+  buf[5] = hex[c & 0xF];
+  return std::string_view(buf, 6);
+  
+}
@@ -0,0 +1,392 @@
+/*
+  dictlazy.cpp
+  
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+  
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+ 
+  https://github.com/visualopsholdings/dict
+*/
+
+#include "dictlazy.hpp"
+#include "dictjson.hpp"
+
+#include <boost/log/trivial.hpp>
+#include <cstring>
+#include <climits>
+
+using namespace vops;
+
+std::optional<DictLazy> Dict::parseLazy(std::string s) {
+
+  DictLazy lazy;
+  lazy._json = std::move(s);
+  
+  if (!json::index(lazy._json, &lazy._index)) {
+    return std::nullopt;
+  }
+  if (lazy._index.empty()) {
+    BOOST_LOG_TRIVIAL(error) << "could not parse JSON: unexpected end";
+    return std::nullopt;
+  }
+  
+  // match up all the brackets so we can skip over things.
+  lazy._ends.resize(lazy._index.size());
+  std::vector<uint32_t> stack;
+  for (size_t n=0; n<lazy._index.size(); n++) {
+    auto c = lazy.at(n);
+    if (c == '{' || c == '[') {
+      stack.push_back(n);
+      continue;
+    }
+    if (c == '}' || c == ']') {
+      if (stack.empty() || lazy.at(stack.back()) != (c == '}' ? '{' : '[')) {
+        BOOST_LOG_TRIVIAL(error) << "could not parse JSON at " << lazy._index[n] << ": unmatched " << c;
+        return std::nullopt;
+      }
+      lazy._ends[stack.back()] = n;
+      stack.pop_back();
+    }
+  }
+  if (!stack.empty()) {
+    BOOST_LOG_TRIVIAL(error) << "could not parse JSON: unexpected end";
+    return std::nullopt;
+  }
+  if (lazy.next(0) != lazy._index.size()) {
+    BOOST_LOG_TRIVIAL(error) << "could not parse JSON: extra characters at the end";
+    return std::nullopt;
+  }
+  
+  return lazy;
+  
+}
+
+size_t DictLazy::next(size_t n) const {
+
+  auto c = at(n);
+  if (c == '{' || c == '[') {
+    return _ends[n] + 1;
+  }
+  return n + 1;
+  
+}
+
+bool DictLazy::keyIs(size_t n, std::string_view key) const {
+
+  auto start = _json.data() + _index[n] + 1;
+  auto left = _json.size() - _index[n] - 1;
+  auto quote = (const char *)memchr(start, '"', left);
+  if (!quote) {
+    return false;
+  }
+  
+  // most keys don't have anything escaped so we can compare them as they are.
+  if (!memchr(start, '\\', quote - start)) {
+    return std::string_view(start, quote - start) == key;
+  }
+  auto k = decode(n);
+  return k && *k == key;
+  
+}
+
+std::optional<std::string> DictLazy::decode(size_t n) const {
+
+  std::string k;
+  size_t i = _index[n] + 1;
+  auto err = json::unescape(_json, &i, &k);
+  if (err) {
+    BOOST_LOG_TRIVIAL(error) << "invalid string " << err;
+    return std::nullopt;
+  }
+  return k;
+  
+}
+
+std::optional<size_t> DictLazy::member(size_t n, std::string_view key) const {
+
+  // { "key" : value , "key" : value }
+  auto end = _ends[n];
+  n++;
+  while (n < end) {
+    if (at(n) != '"' || n + 2 >= end || at(n + 1) != ':') {
+      BOOST_LOG_TRIVIAL(error) << "invalid object at " << _index[n];
+      return std::nullopt;
+    }
+    if (keyIs(n, key)) {
+      return n + 2;
+    }
+    n = next(n + 2);
+    if (n < end && at(n) == ',') {
+      n++;
+    }
+  }
+  return std::nullopt;
+  
+}
+
+std::optional<size_t> DictLazy::element(size_t n, size_t index) const {
+
+  auto end = _ends[n];
+  n++;
+  while (n < end) {
+    if (index == 0) {
+      return n;
+    }
+    index--;
+    n = next(n);
+    if (n < end && at(n) == ',') {
+      n++;
+    }
+  }
+  return std::nullopt;
+  
+}
+
+std::optional<DictLazy::Node> DictLazy::find_pointer(const Dict::Pointer &path) const {
+
+  if (!path.valid()) {
+    return std::nullopt;
+  }
+
+  size_t n = 0;
+  for (auto &t: path) {
+    auto c = at(n);
+    if (c == '{') {
+      auto m = member(n, t.key);
+      if (!m) {
+        BOOST_LOG_TRIVIAL(error) << t.key << " not found";
+        return std::nullopt;
+      }
+      n = *m;
+      continue;
+    }
+    if (c != '[') {
+      BOOST_LOG_TRIVIAL(error) << "only objects and vectors supported";
+      return std::nullopt;
+    }
+    auto el = t.index ? element(n, *t.index) : std::nullopt;
+    if (!el) {
+      BOOST_LOG_TRIVIAL(error) << "invalid index " << t.key;
+      return std::nullopt;
+    }
+    n = *el;
+  }
+  
+  return Node(this, n);
+  
+}
+
+std::optional<DictLazy::Node> DictLazy::find_pointer(const std::string &path) const {
+
+  return find_pointer(Dict::Pointer(path));
+  
+}
+
+DictLazy::Node::Node(const Node &prev, size_t n, std::string_view key): 
+  _lazy(prev._lazy), _n(n), _path(prev._path) {
+  
+  _path += "/";
+  _path += key;
+  
+}
+
+DictLazy::Node::Node(const Node &prev, const std::string &err): 
+  _lazy(nullptr), _n(0), _path(prev._path), _err(err) {
+}
+
+char DictLazy::Node::type() const {
+
+  if (!has_value()) {
+    return 0;
+  }
+  return _lazy->at(_n);
+  
+}
+
+std::optional<DictG> DictLazy::Node::toG() const {
+
+  if (!has_value()) {
+    return std::nullopt;
+  }
+  
+  DictG g;
+  size_t n = _n;
+  if (!json::build(_lazy->_json, _lazy->_index, &n, &g)) {
+    return std::nullopt;
+  }
+  return g;
+  
+}
+
+std::optional<std::string> DictLazy::Node::getString() const {
+
+  if (type() != '"') {
+    return std::nullopt;
+  }
+  return _lazy->decode(_n);
+  
+}
+
+std::optional<long long> DictLazy::Node::getNum() const {
+
+  auto t = type();
+  if (t == 0 || t == '{' || t == '[' || t == '"') {
+    return std::nullopt;
+  }
+  auto g = toG();
+  if (!g) {
+    return std::nullopt;
+  }
+  return Dict::getNum(*g);
+  
+}
+
+std::optional<bool> DictLazy::Node::getBool() const {
+
+  auto t = type();
+  if (t != 't' && t != 'f') {
+    return std::nullopt;
+  }
+  auto g = toG();
+  if (!g) {
+    return std::nullopt;
+  }
+  return Dict::getBool(*g);
+  
+}
+
+std::optional<std::string> DictLazy::Node::getFirstKey() const {
+
+  if (type() != '{' || _lazy->_ends[_n] == _n + 1) {
+    return std::nullopt;
+  }
+  return _lazy->decode(_n + 1);
+  
+}
+
+DictLazy::Node DictLazy::Node::object(std::string_view key) const {
+
+  if (!has_value()) {
+    BOOST_LOG_TRIVIAL(trace) << "unwinding error";
+    return *this;
+  }
+  
+  if (type() != '{') {
+    return Node(*this, "Err: Dict is not an object");
+  }
+  
+  auto m = _lazy->member(_n, key);
+  if (!m) {
+    return Node(*this, "Err: " + std::string(key) + " not found");
+  }
+  
+  return Node(*this, *m, key);
+  
+}
+
+DictLazy::Node DictLazy::Node::vector(int index) const {
+
+  if (!has_value()) {
+    BOOST_LOG_TRIVIAL(trace) << "unwinding error";
+    return *this;
+  }
+  
+  if (type() != '[') {
+    return Node(*this, "Err: Dict is not a vector");
+  }
+  
+  auto el = index < 0 ? std::nullopt : _lazy->element(_n, index);
+  if (!el) {
+    return Node(*this, "Err: index " + std::to_string(index) + " is invalid");
+  }
+  
+  return Node(*this, *el, std::to_string(index));
+  
+}
+
+std::string DictLazy::Node::string() const {
+
+  if (!has_value()) {
+    BOOST_LOG_TRIVIAL(trace) << "unwinding error";
+    return *error();
+  }
+  
+  auto str = getString();
+  if (!str) {
+    return "Err: not a string";
+  }
+  
+  return *str;
+  
+}
+
+bool DictLazy::Node::boolean() const {
+
+  auto b = getBool();
+  if (!b) {
+    return false;
+  }
+  return *b;
+  
+}
+
+long long DictLazy::Node::num() const {
+
+  auto l = getNum();
+  if (!l) {
+    return 0;
+  }
+  return *l;
+  
+}
+
+int DictLazy::Node::size() const {
+
+  if (!has_value()) {
+    BOOST_LOG_TRIVIAL(trace) << "unwinding error";
+    return *errori();
+  }
+  
+  if (type() != '[') {
+    BOOST_LOG_TRIVIAL(trace) << "underlying error is Err: not a vector";
+    return INT_MAX;
+  }
+  
+  int size = 0;
+  auto end = _lazy->_ends[_n];
+  for (auto n = _n + 1; n < end; ) {
+    size++;
+    n = _lazy->next(n);
+    if (n < end && _lazy->at(n) == ',') {
+      n++;
+    }
+  }
+  return size;
+  
+}
+
+std::optional<std::string> DictLazy::Node::error() const {
+
+  if (has_value()) {
+    return std::nullopt;
+  }
+  
+  if (_path.empty()) {
+    return _err;
+  }
+  return "Path: " + _path + " " + _err;
+  
+}
+
+std::optional<int> DictLazy::Node::errori() const {
+
+  if (has_value()) {
+    return std::nullopt;
+  }
+  
+  BOOST_LOG_TRIVIAL(trace) << *error();
+  
+  return INT_MAX;
+  
+}
@@ -0,0 +1,80 @@
+/*
+  dictmmap.cpp
+  
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+  
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+ 
+  https://github.com/visualopsholdings/dict
+*/
+
+#include "dictmmap.hpp"
+
+#include <boost/log/trivial.hpp>
+#include <fstream>
+
+#if __has_include(<sys/mman.h>)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define DICT_MMAP
+#endif
+
+using namespace vops;
+
+MappedFile::MappedFile(const std::string &fn, size_t threshold) {
+
+#ifdef DICT_MMAP
+  int fd = open(fn.c_str(), O_RDONLY);
+  if (fd >= 0) {
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 && (size_t)st.st_size >= threshold) {
+      void *map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (map != MAP_FAILED) {
+        // we read it from start to end.
+        madvise(map, st.st_size, MADV_SEQUENTIAL);
+        _map = map;
+        _size = st.st_size;
+      }
+      else {
+        BOOST_LOG_TRIVIAL(trace) << "couldn't map " << fn << ", reading it";
+      }
+    }
+    close(fd);
+    if (_map) {
+      return;
+    }
+  }
+#endif
+
+  std::ifstream f(fn, std::ios::binary);
+  if (!f) {
+    return;
+  }
+  _buf = std::string((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+  
+}
+
+MappedFile::~MappedFile() {
+
+#ifdef DICT_MMAP
+  if (_map) {
+    munmap(_map, _size);
+  }
+#endif
+
+}
+
+std::optional<std::string_view> MappedFile::data() const {
+
+  if (_map) {
+    return std::string_view((const char *)_map, _size);
+  }
+  if (_buf) {
+    return *_buf;
+  }
+  return std::nullopt;
+  
+}
@@ -0,0 +1,189 @@
+/*
+  dictndjson.cpp
+  
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+  
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+ 
+  https://github.com/visualopsholdings/dict
+*/
+
+#include "dict.hpp"
+#include "dictcodec.hpp"
+#include "dictpool.hpp"
+
+#include <boost/log/trivial.hpp>
+#include <istream>
+#include <ostream>
+
+using namespace vops;
+
+namespace {
+
+struct Chunk {
+  std::vector<DictG> records;
+  size_t lines = 0;
+  std::optional<size_t> bad;
+    // the line in this chunk that couldn't be parsed.
+};
+
+Chunk parseLines(const std::string &buf) {
+
+  Chunk chunk;
+  auto json = DictCodec::get(".json");
+  size_t start = 0;
+  while (start < buf.size()) {
+    auto nl = buf.find('\n', start);
+    if (nl == std::string::npos) {
+      nl = buf.size();
+    }
+    chunk.lines++;
+    
+    // blank lines are ignored.
+    auto first = buf.find_first_not_of(" \t\r", start);
+    if (first != std::string::npos && first < nl) {
+      auto g = json->parse(std::string_view(buf).substr(start, nl - start));
+      if (!g) {
+        chunk.bad = chunk.lines;
+        break;
+      }
+      chunk.records.push_back(std::move(*g));
+    }
+    start = nl + 1;
+  }
+  return chunk;
+  
+}
+
+bool readChunk(std::istream &s, size_t size, std::string *carry, std::string *buf) {
+
+  // a chunk of whole lines, the bit after the last line is carried over
+  // to the next one. A line longer than the chunk just makes it bigger.
+  *buf = std::move(*carry);
+  carry->clear();
+  while (true) {
+    auto start = buf->size();
+    buf->resize(start + size);
+    s.read(buf->data() + start, size);
+    buf->resize(start + s.gcount());
+    if (!s) {
+      break;
+    }
+    // what was there before has no newlines in it, so only look at what we 
+    // just read.
+    auto nl = std::string_view(*buf).substr(start).rfind('\n');
+    if (nl != std::string::npos) {
+      nl += start;
+      *carry = buf->substr(nl + 1);
+      buf->resize(nl + 1);
+      break;
+    }
+  }
+  return !buf->empty();
+  
+}
+
+}
+
+bool Dict::readNDJSON(std::istream &s, std::function<bool (DictG &&)> callback, int threads, size_t chunk) {
+
+  size_t line = 0;
+  bool stopped = false;
+  auto deliver = [&line, &stopped, &callback](Chunk &&c) {
+    for (auto &r: c.records) {
+      if (!callback(std::move(r))) {
+        stopped = true;
+        return true;
+      }
+    }
+    if (c.bad) {
+      BOOST_LOG_TRIVIAL(error) << "invalid JSON on line " << line + *c.bad;
+      return false;
+    }
+    line += c.lines;
+    return true;
+  };
+  
+  std::string carry, buf;
+  
+  if (threads == 1) {
+    while (readChunk(s, chunk, &carry, &buf)) {
+      if (!deliver(parseLines(buf))) {
+        return false;
+      }
+      if (stopped) {
+        return true;
+      }
+    }
+    return true;
+  }
+  
+  // keep a couple of chunks for each thread on the go, and hand them
+  // back in the order they were read.
+  DictPool pool(threads);
+  std::deque<std::future<Chunk>> pending;
+  while (readChunk(s, chunk, &carry, &buf)) {
+    pending.push_back(pool.submit([buf = std::move(buf)]() { return parseLines(buf); }));
+    buf = std::string();
+    while (pending.size() >= (size_t)pool.size() * 2) {
+      auto c = pending.front().get();
+      pending.pop_front();
+      if (!deliver(std::move(c))) {
+        return false;
+      }
+      if (stopped) {
+        return true;
+      }
+    }
+  }
+  while (!pending.empty()) {
+    auto c = pending.front().get();
+    pending.pop_front();
+    if (!deliver(std::move(c))) {
+      return false;
+    }
+    if (stopped) {
+      return true;
+    }
+  }
+  return true;
+  
+}
+
+std::optional<DictV> Dict::readNDJSON(std::istream &s, int threads) {
+
+  DictV records;
+  if (!readNDJSON(s, [&records](DictG &&g) {
+    records.push_back(std::move(g));
+    return true;
+  }, threads)) {
+    return std::nullopt;
+  }
+  return records;
+  
+}
+
+bool Dict::writeNDJSON(std::ostream &s, const DictV &records) {
+
+  std::vector<char> buffer(65536);
+  Sink sink = [&s](std::string_view c) {
+    s.write(c.data(), c.size());
+    return s.good();
+  };
+  size_t line = 0;
+  for (auto &r: records) {
+    line++;
+    if (!write(r, buffer, sink, false)) {
+      BOOST_LOG_TRIVIAL(error) << "could not write line " << line;
+      return false;
+    }
+    s << '\n';
+    if (!s) {
+      BOOST_LOG_TRIVIAL(error) << "could not write line " << line;
+      return false;
+    }
+  }
+  return true;
+  
+}
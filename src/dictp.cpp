@@ -0,0 +1,406 @@
+/*
+  dictp.cpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+
+  https://github.com/visualopsholdings/dict
+*/
+
+#include "dictp.hpp"
+#include "dictjson.hpp"
+#include "dictmmap.hpp"
+
+#include <boost/log/trivial.hpp>
+#include <unordered_map>
+#include <filesystem>
+
+using namespace vops;
+
+struct DictP::Node {
+  std::variant<std::string, DictP::Object, DictP::Vector> value;
+};
+
+namespace vops {
+
+class DictPBuilder {
+
+  // build a DictP straight from the JSON parser, interning the keys as we go.
+  
+public:
+  typedef DictP Value;
+  typedef size_t Object;
+  typedef size_t Vector;
+    // where they start in _members and _elements.
+  typedef Symbol Key;
+  
+  Object beginObject() { return _members.size(); }
+  Key key(std::string_view k);
+  void member(Object &, Key &&k, Value &&v) { _members.push_back({ std::move(k), std::move(v) }); }
+  void endObject(Object &o, Value *out);
+  Vector beginVector() { return _elements.size(); }
+  void element(Vector &, Value &&e) { _elements.push_back(std::move(e)); }
+  void endVector(Vector &v, Value *out);
+  void string(std::string_view s, Value *out) { out->_value = std::make_shared<const DictP::Node>(DictP::Node{ std::string(s) }); }
+  void number(const json::Number &n, Value *out);
+  void boolean(bool b, Value *out) { out->_value = b; }
+  void null(Value *out) { *out = DictP(); }
+  
+  bool includes() const { return _includes; }
+    // there was a "..." key somewhere.
+    
+private:
+  struct Hash {
+    using is_transparent = void;
+    size_t operator()(std::string_view s) const { return std::hash<std::string_view>()(s); }
+  };
+  
+  std::unordered_map<std::string, Symbol, Hash, std::equal_to<>> _keys;
+    // the symbols we have already looked up, so we only go to the global
+    // ones once for each key.
+  bool _includes = false;
+  std::vector<std::pair<Symbol, DictP>> _members;
+  std::vector<DictP> _elements;
+    // what's been parsed in the objects and vectors we are in, so each one
+    // can be made exactly the right size.
+  
+};
+
+}
+
+Symbol DictPBuilder::key(std::string_view k) {
+
+  if (k == "...") {
+    _includes = true;
+  }
+  auto found = _keys.find(k);
+  if (found != _keys.end()) {
+    return found->second;
+  }
+  Symbol sym(k);
+  _keys.emplace(k, sym);
+  return sym;
+  
+}
+
+void DictPBuilder::endObject(Object &o, Value *out) {
+
+  auto first = _members.begin() + o;
+  *out = DictP(DictP::Object(std::make_move_iterator(first), std::make_move_iterator(_members.end())));
+  _members.erase(first, _members.end());
+  
+}
+
+void DictPBuilder::endVector(Vector &v, Value *out) {
+
+  auto first = _elements.begin() + v;
+  *out = DictP(DictP::Vector(std::make_move_iterator(first), std::make_move_iterator(_elements.end())));
+  _elements.erase(first, _elements.end());
+  
+}
+
+void DictPBuilder::number(const json::Number &n, Value *out) {
+
+  if (n.integer) {
+    out->_value = n.num;
+  }
+  else {
+    out->_value = n.d;
+  }
+  
+}
+
+DictP::DictP(const DictG &g) {
+
+  auto obj = Dict::getObjectPtr(g);
+  if (obj) {
+    Object o;
+    o.reserve(obj->size());
+    for (auto &e: *obj) {
+      o.push_back({ Symbol(e.first), DictP(e.second) });
+    }
+    _value = std::make_shared<const Node>(Node{ std::move(o) });
+    return;
+  }
+
+  auto vec = Dict::getVectorPtr(g);
+  if (vec) {
+    Vector v;
+    v.reserve(vec->size());
+    for (auto &e: *vec) {
+      v.push_back(DictP(e));
+    }
+    _value = std::make_shared<const Node>(Node{ std::move(v) });
+    return;
+  }
+
+  std::visit([this](auto &v) {
+    using T = std::decay_t<decltype(v)>;
+    if constexpr (std::is_same_v<T, std::string>) {
+      _value = std::make_shared<const Node>(Node{ v });
+    }
+    else if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, int64_t> || std::is_same_v<T, double>) {
+      _value = v;
+    }
+  }, g.variant());
+
+}
+
+DictP::DictP(Object o): _value(std::make_shared<const Node>(Node{ std::move(o) })) {
+}
+
+DictP::DictP(Vector v): _value(std::make_shared<const Node>(Node{ std::move(v) })) {
+}
+
+DictG DictP::toG() const {
+
+  auto obj = getObject();
+  if (obj) {
+    DictO o;
+    for (auto &e: *obj) {
+      o.insert(e.first.str(), e.second.toG());
+    }
+    return o;
+  }
+
+  auto vec = getVector();
+  if (vec) {
+    DictV v;
+    v.reserve(vec->size());
+    for (auto &e: *vec) {
+      v.push_back(e.toG());
+    }
+    return v;
+  }
+
+  return *getScalar();
+
+}
+
+const DictP::Node *DictP::node() const {
+
+  auto node = std::get_if<std::shared_ptr<const Node>>(&_value);
+  return node ? node->get() : nullptr;
+
+}
+
+const DictP::Object *DictP::getObject() const {
+
+  auto n = node();
+  return n ? std::get_if<Object>(&n->value) : nullptr;
+
+}
+
+const DictP::Vector *DictP::getVector() const {
+
+  auto n = node();
+  return n ? std::get_if<Vector>(&n->value) : nullptr;
+
+}
+
+std::optional<DictG> DictP::getScalar() const {
+
+  auto n = node();
+  if (n) {
+    auto s = std::get_if<std::string>(&n->value);
+    if (!s) {
+      return std::nullopt;
+    }
+    return DictG(*s);
+  }
+  
+  return std::visit([](auto &v) -> DictG {
+    using T = std::decay_t<decltype(v)>;
+    if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, int64_t> || std::is_same_v<T, double>) {
+      return DictG(v);
+    }
+    else {
+      return DictG();
+    }
+  }, _value);
+
+}
+
+bool DictP::same(const DictP &a, const DictP &b) {
+
+  return a._value == b._value;
+
+}
+
+std::optional<DictP> DictP::parseString(const std::string &s, const std::string &format) {
+
+  if (format != ".json") {
+    auto g = Dict::parseString(s, format);
+    if (!g) {
+      return std::nullopt;
+    }
+    return DictP(*g);
+  }
+  
+  return parseJSON(s, nullptr);
+
+}
+
+std::optional<DictP> DictP::parseJSON(std::string_view s, bool *includes) {
+
+  std::vector<uint32_t> index;
+  if (!json::index(s, &index)) {
+    return std::nullopt;
+  }
+  
+  DictP p;
+  DictPBuilder builder;
+  json::Parser<DictPBuilder> parser(s, index, builder);
+  if (!parser.parse(&p)) {
+    return std::nullopt;
+  }
+  if (includes) {
+    *includes = builder.includes();
+  }
+  return p;
+
+}
+
+std::optional<DictP> DictP::parseFile(const std::string &fn) {
+
+  // JSON is parsed straight into a DictP, unless it includes other files.
+  if (std::filesystem::path(fn).extension() == ".json") {
+    MappedFile f(fn, Dict::getMmapThreshold());
+    auto s = f.data();
+    if (!s) {
+      BOOST_LOG_TRIVIAL(error) << "could not parse " << fn;
+      return std::nullopt;
+    }
+    bool includes;
+    auto p = parseJSON(*s, &includes);
+    if (!p) {
+      BOOST_LOG_TRIVIAL(error) << "could not parse " << fn;
+      return std::nullopt;
+    }
+    if (!includes) {
+      return p;
+    }
+  }
+  
+  auto g = Dict::parseFile(fn);
+  if (!g) {
+    return std::nullopt;
+  }
+  return DictP(*g);
+
+}
+
+std::optional<DictP> DictP::find_pointer(const DictP &p, const Dict::Pointer &path) {
+
+  if (!path.valid()) {
+    return std::nullopt;
+  }
+
+  const DictP *node = &p;
+  for (auto &t: path) {
+    auto obj = node->getObject();
+    if (obj) {
+      // if there is no symbol, no object anywhere has that key.
+      auto key = Symbols::global().find(t.key);
+      if (!key) {
+        BOOST_LOG_TRIVIAL(error) << t.key << " not found";
+        return std::nullopt;
+      }
+      auto found = find_if(obj->begin(), obj->end(), [&key](auto &e) { return e.first == *key; });
+      if (found == obj->end()) {
+        BOOST_LOG_TRIVIAL(error) << t.key << " not found";
+        return std::nullopt;
+      }
+      node = &found->second;
+      continue;
+    }
+    auto vec = node->getVector();
+    if (!vec) {
+      BOOST_LOG_TRIVIAL(error) << "only objects and vectors supported";
+      return std::nullopt;
+    }
+    if (!t.index || *t.index >= vec->size()) {
+      BOOST_LOG_TRIVIAL(error) << "invalid index " << t.key;
+      return std::nullopt;
+    }
+    node = &(*vec)[*t.index];
+  }
+
+  return *node;
+
+}
+
+std::optional<DictP> DictP::find_pointer(const DictP &p, const std::string &path) {
+
+  return find_pointer(p, Dict::Pointer(path));
+
+}
+
+std::optional<DictP> DictP::setPath(const DictP &p, Dict::Pointer::const_iterator i, Dict::Pointer::const_iterator end, const DictP &value) {
+
+  if (i == end) {
+    return value;
+  }
+
+  // only this node is copied, and that just copies the pointers to
+  // the children.
+
+  auto obj = p.getObject();
+  if (obj) {
+    // if there is no symbol, no object anywhere has that key. It's only
+    // interned if it's actually added.
+    auto key = Symbols::global().find(i->key);
+    auto found = key ? find_if(obj->begin(), obj->end(), [&key](auto &e) { return e.first == *key; }) : obj->end();
+    if (found == obj->end()) {
+      if (i+1 != end) {
+        BOOST_LOG_TRIVIAL(error) << i->key << " not found";
+        return std::nullopt;
+      }
+      auto newobj = *obj;
+      newobj.push_back({ key ? *key : Symbol(i->key), value });
+      return DictP(std::move(newobj));
+    }
+    auto result = setPath(found->second, i+1, end, value);
+    if (!result) {
+      return std::nullopt;
+    }
+    auto newobj = *obj;
+    newobj[found - obj->begin()].second = *result;
+    return DictP(std::move(newobj));
+  }
+
+  auto vec = p.getVector();
+  if (!vec) {
+    BOOST_LOG_TRIVIAL(error) << "only objects and vectors supported";
+    return std::nullopt;
+  }
+  if (!i->index || *i->index >= vec->size()) {
+    BOOST_LOG_TRIVIAL(error) << "invalid index " << i->key;
+    return std::nullopt;
+  }
+  auto result = setPath((*vec)[*i->index], i+1, end, value);
+  if (!result) {
+    return std::nullopt;
+  }
+  auto newv = *vec;
+  newv[*i->index] = *result;
+  return DictP(std::move(newv));
+
+}
+
+std::optional<DictP> DictP::set_at_pointer(const DictP &p, const Dict::Pointer &path, const DictP &value) {
+
+  if (!path.valid()) {
+    return std::nullopt;
+  }
+  return setPath(p, path.begin(), path.end(), value);
+
+}
+
+std::optional<DictP> DictP::set_at_pointer(const DictP &p, const std::string &path, const DictP &value) {
+
+  return set_at_pointer(p, Dict::Pointer(path), value);
+
+}
@@ -0,0 +1,465 @@
+/*
+  dictpatch.cpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+
+  https://github.com/visualopsholdings/dict
+*/
+
+#include "dict.hpp"
+
+#include <boost/log/trivial.hpp>
+#include <unordered_map>
+#include <unordered_set>
+#include <cmath>
+
+using namespace vops;
+
+namespace vops {
+
+class DictPatcher {
+
+  // apply the ops one at a time, remembering how to put back every change
+  // so if anything fails they can all be unwound.
+  
+public:
+  DictPatcher(DictG &g): _g(g) {}
+  
+  bool apply(const DictO &op);
+  void rollback();
+  
+private:
+  enum class Kind { Set, Unset, Insert, Erase, Root };
+  
+  struct Undo {
+    // what to do to put back a single change.
+    Kind kind;
+    Dict::Pointer path;
+    size_t index;
+    DictG old;
+    bool moved;
+      // a "move" doesn't copy the value. The add takes it back out when it's 
+      // undone and the remove puts it back.
+  };
+  
+  DictG *find(const Dict::Pointer &path) { return Dict::getMutablePath(_g, path.begin(), path.end()); }
+  DictG *parent(const Dict::Pointer &path) { return Dict::getMutablePath(_g, path.begin(), path.end() - 1); }
+  bool add(const Dict::Pointer &path, DictG &&value, bool moved=false);
+  bool remove(const Dict::Pointer &path, DictG *removed=nullptr);
+  void set(DictG *target, const Dict::Pointer &path, DictG &&value, bool moved);
+  void undo(Undo &u, DictG *carry);
+  
+  DictG &_g;
+  std::vector<Undo> _undo;
+  
+};
+
+}
+
+void DictPatcher::set(DictG *target, const Dict::Pointer &path, DictG &&value, bool moved) {
+
+  _undo.push_back({ Kind::Set, path, 0, std::move(*target), moved });
+  *target = std::move(value);
+
+}
+
+bool DictPatcher::add(const Dict::Pointer &path, DictG &&value, bool moved) {
+
+  if (path.size() == 0) {
+    _undo.push_back({ Kind::Root, path, 0, std::move(_g), moved });
+    _g = std::move(value);
+    return true;
+  }
+
+  auto p = parent(path);
+  if (!p) {
+    BOOST_LOG_TRIVIAL(error) << "parent of " << path.path() << " not found";
+    return false;
+  }
+
+  auto last = path.end() - 1;
+  auto obj = std::get_if<DictO>(&p->variant());
+  if (obj) {
+    auto found = Dict::getMutablePtr(*obj, last->key);
+    if (found) {
+      set(found, path, std::move(value), moved);
+      return true;
+    }
+    _undo.push_back({ Kind::Unset, path, 0, DictG(), moved });
+    obj->insert(last->key, std::move(value));
+    return true;
+  }
+
+  auto vec = std::get_if<DictV>(&p->variant());
+  if (!vec) {
+    BOOST_LOG_TRIVIAL(error) << "only objects and vectors supported";
+    return false;
+  }
+  size_t index;
+  if (last->key == "-") {
+    index = vec->size();
+  }
+  else if (last->index && *last->index <= vec->size()) {
+    index = *last->index;
+  }
+  else {
+    BOOST_LOG_TRIVIAL(error) << "invalid index " << last->key;
+    return false;
+  }
+  _undo.push_back({ Kind::Erase, path, index, DictG(), moved });
+  vec->insert(vec->begin() + index, std::move(value));
+  return true;
+
+}
+
+bool DictPatcher::remove(const Dict::Pointer &path, DictG *removed) {
+
+  if (path.size() == 0) {
+    BOOST_LOG_TRIVIAL(error) << "can't remove the whole document";
+    return false;
+  }
+
+  auto p = parent(path);
+  if (!p) {
+    BOOST_LOG_TRIVIAL(error) << "parent of " << path.path() << " not found";
+    return false;
+  }
+
+  // if they want the value, it goes to them and not in the undo.
+  auto last = path.end() - 1;
+  auto obj = std::get_if<DictO>(&p->variant());
+  if (obj) {
+    DictG old;
+    auto pos = Dict::eraseKey(*obj, last->key, removed ? removed : &old);
+    if (!pos) {
+      BOOST_LOG_TRIVIAL(error) << last->key << " not found";
+      return false;
+    }
+    _undo.push_back({ Kind::Insert, path, *pos, std::move(old), removed != nullptr });
+    return true;
+  }
+  
+  auto vec = std::get_if<DictV>(&p->variant());
+  if (!vec || !last->index || *last->index >= vec->size()) {
+    BOOST_LOG_TRIVIAL(error) << "invalid index " << last->key;
+    return false;
+  }
+  auto index = *last->index;
+  auto &old = (*vec)[index];
+  if (removed) {
+    *removed = std::move(old);
+    _undo.push_back({ Kind::Insert, path, index, DictG(), true });
+  }
+  else {
+    _undo.push_back({ Kind::Insert, path, index, std::move(old), false });
+  }
+  vec->erase(vec->begin() + index);
+  return true;
+
+}
+
+void DictPatcher::undo(Undo &u, DictG *carry) {
+
+  // the document is exactly as it was just after the change, so the
+  // path is good.
+  if (u.kind == Kind::Root) {
+    if (u.moved) {
+      *carry = std::move(_g);
+    }
+    _g = std::move(u.old);
+    return;
+  }
+
+  if (u.kind == Kind::Set) {
+    auto target = find(u.path);
+    if (u.moved) {
+      *carry = std::move(*target);
+    }
+    *target = std::move(u.old);
+    return;
+  }
+  
+  auto p = parent(u.path);
+  auto last = u.path.end() - 1;
+  auto obj = std::get_if<DictO>(&p->variant());
+  if (obj) {
+    if (u.kind == Kind::Unset) {
+      Dict::eraseKey(*obj, last->key, u.moved ? carry : nullptr);
+    }
+    else {
+      Dict::insertKey(*obj, u.index, last->key, std::move(u.moved ? *carry : u.old));
+    }
+    return;
+  }
+
+  auto vec = std::get_if<DictV>(&p->variant());
+  if (u.kind == Kind::Erase) {
+    if (u.moved) {
+      *carry = std::move((*vec)[u.index]);
+    }
+    vec->erase(vec->begin() + u.index);
+  }
+  else {
+    vec->insert(vec->begin() + u.index, std::move(u.moved ? *carry : u.old));
+  }
+
+}
+
+void DictPatcher::rollback() {
+
+  DictG carry;
+  for (auto u = _undo.rbegin(); u != _undo.rend(); u++) {
+    undo(*u, &carry);
+  }
+  _undo.clear();
+
+}
+
+bool Dict::equals(const DictG &a, const DictG &b) {
+
+  // integers are compared exactly, and a double is only the same as an
+  // integer if it's exactly that integer.
+  auto aint = std::get_if<int64_t>(&a.variant());
+  auto bint = std::get_if<int64_t>(&b.variant());
+  auto adbl = std::get_if<double>(&a.variant());
+  auto bdbl = std::get_if<double>(&b.variant());
+  if (aint && bint) {
+    return *aint == *bint;
+  }
+  if (adbl && bdbl) {
+    return *adbl == *bdbl;
+  }
+  if ((aint && bdbl) || (adbl && bint)) {
+    auto i = aint ? *aint : *bint;
+    auto d = adbl ? *adbl : *bdbl;
+    return d >= -0x1p63 && d < 0x1p63 && std::trunc(d) == d && (int64_t)d == i;
+  }
+
+  if (a.variant().index() != b.variant().index()) {
+    return false;
+  }
+
+  auto aobj = getObjectPtr(a);
+  if (aobj) {
+    auto bobj = getObjectPtr(b);
+    if (aobj->size() != bobj->size()) {
+      return false;
+    }
+    for (auto &e: *aobj) {
+      auto other = getGenericPtr(bobj, e.first);
+      if (!other || !equals(e.second, *other)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  auto avec = getVectorPtr(a);
+  if (avec) {
+    auto bvec = getVectorPtr(b);
+    if (avec->size() != bvec->size()) {
+      return false;
+    }
+    for (size_t i=0; i<avec->size(); i++) {
+      if (!equals((*avec)[i], (*bvec)[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  if (a.is_null()) {
+    return true;
+  }
+
+  auto astr = getStringView(a);
+  if (astr) {
+    return *astr == *getStringView(b);
+  }
+
+  return getBool(a) == getBool(b);
+
+}
+
+bool DictPatcher::apply(const DictO &op) {
+
+  auto name = Dict::getStringView(&op, "op");
+  auto path = Dict::getStringView(&op, "path");
+  if (!name || !path) {
+    BOOST_LOG_TRIVIAL(error) << "patch needs op and path";
+    return false;
+  }
+  Dict::Pointer p{std::string(*path)};
+  if (!p.valid()) {
+    return false;
+  }
+
+  if (*name == "add" || *name == "replace" || *name == "test") {
+    auto value = Dict::getGenericPtr(&op, "value");
+    if (!value) {
+      BOOST_LOG_TRIVIAL(error) << *name << " needs a value";
+      return false;
+    }
+    if (*name == "add") {
+      return add(p, DictG(*value));
+    }
+    auto target = find(p);
+    if (!target) {
+      BOOST_LOG_TRIVIAL(error) << p.path() << " not found";
+      return false;
+    }
+    if (*name == "test") {
+      return Dict::equals(*target, *value);
+    }
+    if (p.size() == 0) {
+      return add(p, DictG(*value));
+    }
+    set(target, p, DictG(*value), false);
+    return true;
+  }
+
+  if (*name == "remove") {
+    return remove(p);
+  }
+
+  if (*name == "move" || *name == "copy") {
+    auto from = Dict::getStringView(&op, "from");
+    if (!from) {
+      BOOST_LOG_TRIVIAL(error) << *name << " needs from";
+      return false;
+    }
+    Dict::Pointer f{std::string(*from)};
+    if (!f.valid()) {
+      return false;
+    }
+    if (*name == "copy") {
+      auto value = find(f);
+      if (!value) {
+        BOOST_LOG_TRIVIAL(error) << f.path() << " not found";
+        return false;
+      }
+      return add(p, DictG(*value));
+    }
+    if (p.path() == f.path()) {
+      return find(f) != nullptr;
+    }
+    if (p.path().starts_with(f.path() + "/")) {
+      BOOST_LOG_TRIVIAL(error) << "can't move " << f.path() << " into itself";
+      return false;
+    }
+    // the value goes straight from one place to the other.
+    DictG value;
+    if (!remove(f, &value)) {
+      return false;
+    }
+    if (!add(p, std::move(value), true)) {
+      // so the remove can still be put back.
+      _undo.back().old = std::move(value);
+      _undo.back().moved = false;
+      return false;
+    }
+    return true;
+  }
+
+  BOOST_LOG_TRIVIAL(error) << "unknown patch op " << *name;
+  return false;
+
+}
+
+bool Dict::applyPatch(DictG &g, const DictV &ops) {
+
+  DictPatcher patcher(g);
+  for (auto &o: ops) {
+    auto op = getObjectPtr(o);
+    if (!op || !patcher.apply(*op)) {
+      if (op) {
+        BOOST_LOG_TRIVIAL(error) << "patch failed at " << toString(o, false);
+      }
+      else {
+        BOOST_LOG_TRIVIAL(error) << "patch ops must be objects";
+      }
+      patcher.rollback();
+      return false;
+    }
+  }
+
+  return true;
+
+}
+
+void Dict::mergePatch(DictG &target, DictG &&patch) {
+
+  auto pobj = std::get_if<DictO>(&patch.variant());
+  if (!pobj) {
+    target = std::move(patch);
+    return;
+  }
+  
+  if (!std::get_if<DictO>(&target.variant())) {
+    target = DictO();
+  }
+  auto tobj = std::get_if<DictO>(&target.variant());
+  
+  // index the target once, so this is linear in the size of the patch
+  // and not patch * target. 
+  std::unordered_map<std::string_view, DictG *> index;
+  index.reserve(tobj->size());
+  for (auto &e: *tobj) {
+    index.emplace(e.first, &e.second);
+  }
+  
+  // nothing is added or removed from the target until the end so the index
+  // stays good.
+  std::unordered_set<std::string_view> removed;
+  std::vector<std::pair<std::string, DictG> *> added;
+  for (auto &e: *pobj) {
+    auto found = index.find(e.first);
+    if (e.second.is_null()) {
+      if (found != index.end()) {
+        removed.insert(found->first);
+      }
+      continue;
+    }
+    if (found != index.end()) {
+      mergePatch(*found->second, std::move(e.second));
+    }
+    else {
+      added.push_back(&e);
+    }
+  }
+  
+  if (!removed.empty()) {
+    DictO newobj;
+    for (auto &e: *tobj) {
+      if (!removed.contains(e.first)) {
+        newobj.insert(e.first, std::move(e.second));
+      }
+    }
+    *tobj = std::move(newobj);
+  }
+  
+  for (auto e: added) {
+    // new values still need the nulls taken out of them.
+    DictG value;
+    mergePatch(value, std::move(e->second));
+    tobj->insert(e->first, std::move(value));
+  }
+  
+}
+
+DictG Dict::deepMerge(std::vector<DictG> &&layers) {
+
+  if (layers.empty()) {
+    return DictG();
+  }
+  
+  DictG result = std::move(layers[0]);
+  for (auto i = layers.begin() + 1; i != layers.end(); i++) {
+    mergePatch(result, std::move(*i));
+  }
+  return result;
+  
+}
@@ -0,0 +1,56 @@
+/*
+  dictpool.cpp
+  
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+  
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+ 
+  https://github.com/visualopsholdings/dict
+*/
+
+#include "dictpool.hpp"
+
+using namespace vops;
+
+DictPool::DictPool(int threads) {
+
+  if (threads <= 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  for (int i=0; i<threads; i++) {
+    _threads.push_back(std::thread([this]() { worker(); }));
+  }
+  
+}
+
+DictPool::~DictPool() {
+
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stop = true;
+  }
+  _cond.notify_all();
+  for (auto &t: _threads) {
+    t.join();
+  }
+  
+}
+
+void DictPool::worker() {
+
+  while (true) {
+    std::function<void ()> task;
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _cond.wait(lock, [this]() { return _stop || !_queue.empty(); });
+      if (_queue.empty()) {
+        return;
+      }
+      task = std::move(_queue.front());
+      _queue.pop_front();
+    }
+    task();
+  }
+  
+}
@@ -15,220 +15,358 @@
 
 using namespace vops;
 
-bool extractPath(const std::string &path, std::string *loc, std::string *remain) {
+std::optional<size_t> decodeIndex(const std::string &token) {
 
-  if (path.size() == 0) {
-    BOOST_LOG_TRIVIAL(error) << "path is empty";
-    return false;
+  // only plain digits, and no leading zeros.
+  if (token.empty() || token.size() > 19 || (token.size() > 1 && token[0] == '0')) {
+    return std::nullopt;
   }
-  if (path[0] != '/') {
-    BOOST_LOG_TRIVIAL(error) << "path must start with /";
-    return false;
+  size_t index = 0;
+  for (auto c: token) {
+    if (c < '0' || c > '9') {
+      return std::nullopt;
+    }
+    index = (index * 10) + (c - '0');
   }
-  
-  auto rem = path.substr(1);
-  auto slash = rem.find('/');
-  *loc = rem.substr(0, slash);
-  *remain = slash == std::string::npos ? "" : rem.substr(slash);
-  return true;
+  return index;
   
 }
 
-std::optional<DictG> Dict::getVecPath(const DictV &v, const std::string &path) {
+Dict::Pointer::Pointer(const std::string &path): _path(path), _valid(true) {
 
-  std::string loc;
-  std::string remain;
-  if (!extractPath(path, &loc, &remain)) {
-    return std::nullopt;
+  if (path.empty()) {
+    // the whole document.
+    return;
   }
-  
-  int index;
-  std::stringstream ss(loc);
-  ss >> index;
-
-  if (index >= v.size()) {
-    BOOST_LOG_TRIVIAL(error) << "index beyond end of vector " << index;
-    return std::nullopt;
+  if (path[0] != '/') {
+    BOOST_LOG_TRIVIAL(error) << "path must start with /";
+    _valid = false;
+    return;
   }
   
-  auto subobj = v[index];
-  
-  if (remain.size() > 0) {
-    return getGPath(subobj, remain);
+  size_t start = 1;
+  while (true) {
+    auto slash = path.find('/', start);
+    auto end = slash == std::string::npos ? path.size() : slash;
+    Token token;
+    token.key.reserve(end - start);
+    for (size_t i=start; i<end; i++) {
+      if (path[i] != '~') {
+        token.key += path[i];
+        continue;
+      }
+      i++;
+      if (i < end && path[i] == '0') {
+        token.key += '~';
+      }
+      else if (i < end && path[i] == '1') {
+        token.key += '/';
+      }
+      else {
+        BOOST_LOG_TRIVIAL(error) << "invalid escape in path " << path;
+        _valid = false;
+        return;
+      }
+    }
+    token.index = decodeIndex(token.key);
+    _tokens.push_back(token);
+    if (slash == std::string::npos) {
+      break;
+    }
+    start = slash + 1;
   }
-
-  return subobj;
   
 }
 
-std::optional<DictG> Dict::getObjPath(const DictO &obj, const std::string &path) {
+const DictG *Dict::getVecPath(const DictV &v, TokenIter i, TokenIter end) {
 
-  std::string loc;
-  std::string remain;
-  if (!extractPath(path, &loc, &remain)) {
-    return std::nullopt;
+  if (!i->index) {
+    BOOST_LOG_TRIVIAL(error) << "invalid index " << i->key;
+    return nullptr;
   }
   
-  auto subobj = obj.get(loc);
-
-  if (!subobj.has_value()) {
-    BOOST_LOG_TRIVIAL(error) << subobj.error().what();
-    return std::nullopt;
+  if (*i->index >= v.size()) {
+    BOOST_LOG_TRIVIAL(error) << "index beyond end of vector " << *i->index;
+    return nullptr;
   }
   
+  return getGPath(v[*i->index], i+1, end);
   
-  if (remain.size() > 0) {
-    return getGPath(subobj.value(), remain);
+}
+
+const DictG *Dict::getObjPath(const DictO &obj, TokenIter i, TokenIter end) {
+
+  auto subobj = getGenericPtr(&obj, i->key);
+  if (!subobj) {
+    BOOST_LOG_TRIVIAL(error) << i->key << " not found";
+    return nullptr;
   }
   
-  return subobj.value();
+  return getGPath(*subobj, i+1, end);
 
 }
 
-std::optional<DictG> Dict::getGPath(const DictG &g, const std::string &path) {
+const DictG *Dict::getGPath(const DictG &g, TokenIter i, TokenIter end) {
 
-  auto obj = Dict::getObject(g);
+  if (i == end) {
+    return &g;
+  }
+  
+  auto obj = Dict::getObjectPtr(g);
   if (!obj) {
-    auto vec = Dict::getVector(g);
+    auto vec = Dict::getVectorPtr(g);
     if (!vec) {
       BOOST_LOG_TRIVIAL(error) << "only objects and vectors supported";
-      return std::nullopt;
+      return nullptr;
     }
-    return getVecPath(*vec, path);
+    return getVecPath(*vec, i, end);
   }
 
-  return getObjPath(*obj, path);
+  return getObjPath(*obj, i, end);
+  
+}
+
+const DictG *Dict::find_pointer_ptr(const DictG &g, const Pointer &path) {
+
+  if (!path.valid()) {
+    return nullptr;
+  }
+  return getGPath(g, path.begin(), path.end());
   
 }
 
+std::optional<DictG> Dict::find_pointer(const DictG &g, const Pointer &path) {
+
+  auto result = find_pointer_ptr(g, path);
+  if (!result) {
+    return std::nullopt;
+  }
+  return *result;
+
+}
+
 std::optional<DictG> Dict::find_pointer(const DictG &g, const std::string &path) {
 
-  return getGPath(g, path);
+  return find_pointer(g, Pointer(path));
 
 }
 
-std::optional<DictO> Dict::setObjPath(const DictO &obj, const std::string &path, const DictG &value) {
+DictG *Dict::getMutablePtr(DictO &obj, std::string_view name) {
 
-//  BOOST_LOG_TRIVIAL(trace) << "setObjPath " << path << ", " << toString(value);
+  // same lookup as the const one, we just own it.
+  return const_cast<DictG *>(getGenericPtr(&obj, name));
+  
+}
 
-  std::string loc;
-  std::string remain;
-  if (!extractPath(path, &loc, &remain)) {
-    return std::nullopt;
+DictG *Dict::getMutablePath(DictG &g, TokenIter i, TokenIter end) {
+
+  return const_cast<DictG *>(getGPath(g, i, end));
+  
+}
+
+bool Dict::setObjPath(DictO &obj, TokenIter i, TokenIter end, DictG &&value) {
+
+//  BOOST_LOG_TRIVIAL(trace) << "setObjPath " << i->key << ", " << toString(value);
+
+  auto o = getMutablePtr(obj, i->key);
+  if (!o) {
+    if (i+1 != end) {
+      BOOST_LOG_TRIVIAL(error) << i->key << " not found";
+      return false;
+    }
+    // we know it's not there.
+    obj.insert(i->key, std::move(value));
+    return true;
   }
+  
+  return setGPath(*o, i+1, end, std::move(value));
+  
+}
 
-//  BOOST_LOG_TRIVIAL(trace) << loc << ", " << remain;
+bool Dict::setVecPath(DictV &v, TokenIter i, TokenIter end, DictG &&value) {
 
-  DictO newobj;
+//  BOOST_LOG_TRIVIAL(trace) << "setVecPath " << i->key << ", " << toString(value);
+
+  if (!i->index) {
+    BOOST_LOG_TRIVIAL(error) << "invalid index " << i->key;
+    return false;
+  }
   
-  // copy all other fields.
-  for (auto e: obj) {
-    if (get<0>(e) != loc) {
-      newobj[get<0>(e)] = get<1>(e);
-    }
+  if (*i->index >= v.size()) {
+    BOOST_LOG_TRIVIAL(error) << "index beyond end of vector " << *i->index;
+    return false;
   }
   
-  if (remain.size() > 0) {
-//    BOOST_LOG_TRIVIAL(trace) << toString(obj);
-    auto o = obj.get(loc);
-    if (!o) {
-      BOOST_LOG_TRIVIAL(error) << loc << " not found";
-      return std::nullopt;
+  return setGPath(v[*i->index], i+1, end, std::move(value));
+
+}
+
+bool Dict::setGPath(DictG &g, TokenIter i, TokenIter end, DictG &&value) {
+
+  if (i == end) {
+    g = std::move(value);
+    return true;
+  }
+  
+  auto obj = std::get_if<DictO>(&g.variant());
+  if (!obj) {
+    auto vec = std::get_if<DictV>(&g.variant());
+    if (!vec) {
+      BOOST_LOG_TRIVIAL(error) << "only objects and vectors supported";
+      return false;
     }
-    auto result = setGPath(*o, remain, value);
-    newobj[loc] = *result;
-    return newobj;
+    return setVecPath(*vec, i, end, std::move(value));
   }
   
-  newobj[loc] = value;
+  return setObjPath(*obj, i, end, std::move(value));
   
-  return newobj;
+}
+
+bool Dict::set_at_pointer_in_place(DictG &g, const Pointer &path, DictG &&value) {
+
+  if (!path.valid()) {
+    return false;
+  }
   
+  // nothing is changed until we get to the very end so a bad path leaves
+  // g alone.
+  return setGPath(g, path.begin(), path.end(), std::move(value));
+
 }
 
-std::optional<DictV> Dict::setVecPath(const DictV &v, const std::string &path, const DictG &value) {
+bool Dict::set_at_pointer_in_place(DictG &g, const std::string &path, DictG &&value) {
 
-//  BOOST_LOG_TRIVIAL(trace) << "setVecPath " << path << ", " << toString(value);
-//  BOOST_LOG_TRIVIAL(trace) << toString(v);
+  return set_at_pointer_in_place(g, Pointer(path), std::move(value));
 
-  std::string loc;
-  std::string remain;
-  if (!extractPath(path, &loc, &remain)) {
+}
+
+std::optional<DictG> Dict::set_at_pointer(DictG &&g, const Pointer &path, const DictG &value) {
+
+  DictG result = std::move(g);
+  if (!set_at_pointer_in_place(result, path, DictG(value))) {
+    g = std::move(result);
     return std::nullopt;
   }
+  return result;
 
-//  BOOST_LOG_TRIVIAL(trace) << loc << ", " << remain;
+}
 
-  int index;
-  std::stringstream ss(loc);
-  ss >> index;
+std::optional<DictG> Dict::set_at_pointer(DictG &&g, const std::string &path, const DictG &value) {
 
-  if (index >= v.size()) {
-    BOOST_LOG_TRIVIAL(error) << "index beyond end of vector " << index;
-    return std::nullopt;
+  return set_at_pointer(std::move(g), Pointer(path), value);
+
+}
+
+std::optional<DictG> Dict::set_at_pointer(const DictG &g, const Pointer &path, const DictG &value) {
+
+  return set_at_pointer(DictG(g), path, value);
+
+}
+
+std::optional<DictG> Dict::set_at_pointer(const DictG &g, const std::string &path, const DictG &value) {
+
+  return set_at_pointer(DictG(g), Pointer(path), value);
+
+}
+
+typedef std::vector<size_t>::const_iterator PointerIter;
+
+void walkPointers(const DictG &g, const std::vector<Dict::Pointer> &pointers, PointerIter lo, PointerIter hi, 
+    size_t depth, std::string *path, std::vector<Result> *results) {
+
+  // all the pointers from lo to hi share the first "depth" tokens, and they are
+  // sorted so the ones that end here come first.
+  
+  while (lo != hi && pointers[*lo].size() == depth) {
+    (*results)[*lo] = Result(g, *path);
+    lo++;
   }
   
-  DictV newv;
+  auto obj = Dict::getObjectPtr(g);
+  auto vec = obj ? nullptr : Dict::getVectorPtr(g);
+  
+  // the path is shared all the way down, we just add to it and take it off again.
+  auto len = path->size();
   
-  // copy all other indexes.
-  int i=0;
-  for (auto e: v) {
-    if (i != index) {
-      newv.push_back(e);
+  while (lo != hi) {
+  
+    // all of these have the same next token.
+    auto token = pointers[*lo].begin() + depth;
+    auto next = lo + 1;
+    while (next != hi && (pointers[*next].begin() + depth)->key == token->key) {
+      next++;
+    }
+    
+    const DictG *child = nullptr;
+    std::string err;
+    if (obj) {
+      child = Dict::getGenericPtr(obj, token->key);
+      if (!child) {
+        err = "Err: " + token->key + " not found";
+      }
+    }
+    else if (vec) {
+      if (token->index && *token->index < vec->size()) {
+        child = &(*vec)[*token->index];
+      }
+      else {
+        err = "Err: index " + token->key + " is invalid";
+      }
     }
     else {
-      newv.push_back(0);
+      err = "Err: only objects and vectors supported";
     }
-    i++;
-  }
-  
-  if (remain.size() > 0) {
-//    BOOST_LOG_TRIVIAL(trace) << toString(v[index]);
-    auto result = setGPath(v[index], remain, value);
-    if (!result) {
-      return std::nullopt;
+    
+    if (child) {
+      *path += "/";
+      *path += token->key;
+      walkPointers(*child, pointers, lo, next, depth + 1, path, results);
+      path->resize(len);
+    }
+    else {
+      for (auto i=lo; i != next; i++) {
+        (*results)[*i] = Result(Result(std::nullopt, *path), rfl::Error(err));
+      }
     }
-    newv[index] = *result;
-    return newv;
+    lo = next;
   }
   
-//  BOOST_LOG_TRIVIAL(trace) << "before " << toString(newv);
-  newv[index] = value;
-//  BOOST_LOG_TRIVIAL(trace) << "after " << toString(newv);
-  
-  return newv;
-
 }
 
-std::optional<DictG> Dict::setGPath(const DictG &g, const std::string &path, const DictG &value) {
+std::vector<Result> Dict::findPointers(const DictG &g, const std::vector<Pointer> &pointers) {
 
-//  BOOST_LOG_TRIVIAL(trace) << "setGPath " << path << ", " << toString(value);
-
-  auto obj = getObject(g);
-  if (!obj) {
-    auto vec = getVector(g);
-    if (!vec) {
-      BOOST_LOG_TRIVIAL(error) << "only objects and vectors supported";
-      return std::nullopt;
-    }
-    auto result = setVecPath(*vec, path, value);
-    if (!result) {
-      return std::nullopt;
+  std::vector<Result> results(pointers.size(), Result(std::nullopt));
+  
+  // sorting the pointers by their tokens gives us a prefix tree for free, so
+  // common prefixes are only walked once.
+  std::vector<size_t> order;
+  order.reserve(pointers.size());
+  for (size_t i=0; i<pointers.size(); i++) {
+    if (!pointers[i].valid()) {
+      results[i] = Result(Result(std::nullopt), rfl::Error("Err: invalid pointer " + pointers[i].path()));
+      continue;
     }
-    return *result;
+    order.push_back(i);
   }
+  std::sort(order.begin(), order.end(), [&pointers](size_t a, size_t b) {
+    return std::lexicographical_compare(pointers[a].begin(), pointers[a].end(), pointers[b].begin(), pointers[b].end(), 
+      [](auto &x, auto &y) { return x.key < y.key; });
+  });
   
-  auto result = setObjPath(*obj, path, value);
-  if (!result) {
-    return std::nullopt;
-  }
-  return *result;
+  std::string path;
+  walkPointers(g, pointers, order.begin(), order.end(), 0, &path, &results);
+  
+  return results;
   
 }
 
-std::optional<DictG> Dict::set_at_pointer(const DictG &g, const std::string &path, const DictG &value) {
+std::vector<Result> Dict::findPointers(const DictG &g, const std::vector<std::string> &paths) {
 
-  return setGPath(g, path, value);
+  std::vector<Pointer> pointers;
+  pointers.reserve(paths.size());
+  for (auto &p: paths) {
+    pointers.push_back(Pointer(p));
+  }
+  return findPointers(g, pointers);
   
-
-}
\ No newline at end of file
+}
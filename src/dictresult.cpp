@@ -21,7 +21,7 @@ using namespace vops;
 Result::Result(std::optional<DictG> g): rfl::Result<DictG>(DictG()), _path("") {
 
   if (g) {
-    rfl::Result<DictG>::operator=(rfl::Result<DictG>(*g)); 
+    rfl::Result<DictG>::operator=(rfl::Result<DictG>(std::move(*g))); 
   }
   else {
     rfl::Result<DictG>::operator=(rfl::Unexpected<rfl::Error>(rfl::Error("nullopt"))); 
@@ -32,7 +32,7 @@ Result::Result(std::optional<DictG> g): rfl::Result<DictG>(DictG()), _path("") {
 Result::Result(std::optional<DictG> g, const std::string &path): rfl::Result<DictG>(DictG()), _path(path) {
 
   if (g) {
-    rfl::Result<DictG>::operator=(rfl::Result<DictG>(*g)); 
+    rfl::Result<DictG>::operator=(rfl::Result<DictG>(std::move(*g))); 
   }
   else {
     rfl::Result<DictG>::operator=(rfl::Unexpected<rfl::Error>(rfl::Error("nullopt"))); 
@@ -57,14 +57,14 @@ Result Result::object(const std::string &key) {
     return *this;
   }
   
-  auto obj = Dict::getObject(*this);
+  auto obj = Dict::getObjectPtr(**this);
   if (!obj) {
     return Result(*this, rfl::Error("Err: Dict is not an object"));
   }
   
 //  BOOST_LOG_TRIVIAL(trace) << Dict::toString(*obj);
 
-  auto elem = obj->get(key);
+  auto elem = Dict::getGenericPtr(obj, key);
   if (!elem) {
     return Result(*this, rfl::Error("Err: " + key + " not found"));
   }
@@ -246,3 +246,214 @@ std::optional<int> Result::errori() {
 }
 
 
+ResultRef::ResultRef(const DictG &g): _root(std::shared_ptr<const DictG>(), &g), _node(&g) {
+}
+
+ResultRef::ResultRef(DictG &&g): _root(std::make_shared<const DictG>(std::move(g))) {
+  _node = _root.get();
+}
+
+ResultRef::ResultRef(std::shared_ptr<const DictG> root): _root(root), _node(root.get()) {
+
+  if (!_node) {
+    _err = "nullopt";
+  }
+  
+}
+
+std::shared_ptr<const DictG> ResultRef::share(const std::optional<DictG> &g) {
+
+  if (!g) {
+    return nullptr;
+  }
+  return std::shared_ptr<const DictG>(std::shared_ptr<const DictG>(), &(*g));
+  
+}
+
+std::shared_ptr<const DictG> ResultRef::share(std::optional<DictG> &&g) {
+
+  if (!g) {
+    return nullptr;
+  }
+  return std::make_shared<const DictG>(std::move(*g));
+  
+}
+
+ResultRef::ResultRef(const ResultRef &prev, const DictG *node, const std::string &path): 
+  _root(prev._root), _node(node), _path(path) {
+}
+
+ResultRef::ResultRef(const ResultRef &prev, const std::string &err): 
+  _root(prev._root), _node(nullptr), _path(prev._path), _err(err) {
+}
+
+ResultRef ResultRef::object(const std::string &key) {
+
+  if (!has_value()) {
+    BOOST_LOG_TRIVIAL(trace) << "unwinding error";
+    return *this;
+  }
+  
+  auto obj = Dict::getObjectPtr(*_node);
+  if (!obj) {
+    return ResultRef(*this, "Err: Dict is not an object");
+  }
+  
+  auto elem = Dict::getGenericPtr(obj, key);
+  if (!elem) {
+    return ResultRef(*this, "Err: " + key + " not found");
+  }
+  
+  return ResultRef(*this, elem, _path + "/" + key);
+  
+}
+
+DictO ResultRef::object() {
+
+  if (!has_value()) {
+    BOOST_LOG_TRIVIAL(error) << "error: " << *error() << " returning empty object";
+    return DictO();
+  }
+
+  auto o = Dict::getObjectPtr(*_node);
+  if (!o) {
+    BOOST_LOG_TRIVIAL(error) << "error: Dict is not an object returning empty object";
+    return DictO();
+  }
+  
+  return *o;
+  
+}
+
+ResultRef ResultRef::vector(int index) {
+
+  if (!has_value()) {
+    BOOST_LOG_TRIVIAL(trace) << "unwinding error";
+    return *this;
+  }
+  
+  auto v = Dict::getVectorPtr(*_node);
+  if (!v) {
+    return ResultRef(*this, "Err: Dict is not a vector");
+  }
+  
+  if (index < 0 || (size_t)index >= v->size()) {
+    std::stringstream ss;
+    ss << "Err: index " << index << " is invalid";
+    return ResultRef(*this, ss.str());
+  }
+  
+  return ResultRef(*this, &(*v)[index], _path + "/" + std::to_string(index));
+
+}
+
+DictV ResultRef::vector() {
+
+  if (!has_value()) {
+    BOOST_LOG_TRIVIAL(error) << "error: " << *error() << " returning empty vector";
+    return DictV();
+  }
+
+  auto v = Dict::getVectorPtr(*_node);
+  if (!v) {
+    BOOST_LOG_TRIVIAL(error) << "error: Dict is not a vector returning empty vector";
+    return DictV();
+  }
+  
+  return *v;
+  
+}
+
+int ResultRef::size() {
+
+  if (!has_value()) {
+    BOOST_LOG_TRIVIAL(trace) << "unwinding error";
+    return *errori();
+  }
+  
+  auto v = Dict::getVectorPtr(*_node);
+  if (!v) {
+    BOOST_LOG_TRIVIAL(trace) << "underlying error is Err: not a vector";
+    return INT_MAX;
+  }
+  
+  return v->size();
+  
+}
+
+std::string ResultRef::string() {
+
+  if (!has_value()) {
+    BOOST_LOG_TRIVIAL(trace) << "unwinding error";
+    return *error();
+  }
+  
+  auto str = Dict::getStringView(*_node);
+  if (!str) {
+    return "Err: not a string";
+  }
+
+  return std::string(*str);
+  
+}
+
+bool ResultRef::boolean() {
+
+  if (!has_value()) {
+    return false;
+  }
+  
+  auto b = Dict::getBool(*_node);
+  if (!b) {
+    return false;
+  }
+
+  return *b;
+  
+}
+
+long long ResultRef::num() {
+
+  if (!has_value()) {
+    return 0;
+  }
+  
+  auto l = Dict::getNum(*_node);
+  if (!l) {
+    return 0;
+  }
+
+  return *l;
+  
+}
+
+std::optional<std::string> ResultRef::error() {
+
+  if (has_value()) {
+    return std::nullopt;
+  }
+
+  std::stringstream ss;
+  if (!_path.empty()) {
+    ss << "Path: " << _path << " ";
+  }
+  ss << _err;
+  
+  BOOST_LOG_TRIVIAL(trace) << "ResultRef::error " << ss.str();
+
+  return ss.str();
+  
+}
+
+std::optional<int> ResultRef::errori() {
+
+  if (has_value()) {
+    return std::nullopt;
+  }
+
+  BOOST_LOG_TRIVIAL(trace) << *error();
+  
+  return INT_MAX;
+  
+}
+
@@ -0,0 +1,590 @@
+/*
+  dictsimd.cpp
+  
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+  
+  A JSON parser that works in 2 stages like simdjson.
+  
+  The first stage goes through the input 64 bytes at a time and uses SIMD to 
+  make bit masks of the quotes, backslashes, structural characters etc. From 
+  those it works out what is inside a string with a few bit tricks and makes
+  an index of where every structural character, string and scalar starts. It 
+  also checks the input is all ASCII, and only if it isn't is the UTF-8 
+  checked properly.
+  
+  The second stage just walks that index and makes the DictG.
+  
+  There are also SIMD versions of finding the next character that needs to be 
+  escaped in a string and checking UTF-8, which are used for parsing and writing.
+  
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+ 
+  https://github.com/visualopsholdings/dict
+*/
+
+#include "dict.hpp"
+#include "dictjson.hpp"
+
+#include <boost/log/trivial.hpp>
+#include <cstring>
+#include <atomic>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DICT_X86
+#endif
+
+using namespace vops;
+
+namespace {
+
+struct Block {
+  uint64_t quote;
+  uint64_t backslash;
+  uint64_t op;
+  uint64_t ws;
+  uint64_t ctrl;
+  uint64_t high;
+};
+
+typedef void (*Classify)(const char *p, Block *b);
+
+void classifyScalar(const char *p, Block *b) {
+
+  memset(b, 0, sizeof(Block));
+  for (int i=0; i<64; i++) {
+    unsigned char c = p[i];
+    uint64_t bit = 1ULL << i;
+    switch (c) {
+    case '"': b->quote |= bit; break;
+    case '\\': b->backslash |= bit; break;
+    case '{': case '}': case '[': case ']': case ':': case ',': b->op |= bit; break;
+    case ' ': case '\t': case '\n': case '\r': b->ws |= bit; break;
+    }
+    if (c < 0x20) {
+      b->ctrl |= bit;
+    }
+    if (c >= 0x80) {
+      b->high |= bit;
+    }
+  }
+  
+}
+
+#ifdef DICT_X86
+
+// [ and ] are { and } without 0x20, so or that in and we only need 2 compares
+// for all of them.
+
+__attribute__((target("sse4.2")))
+void classifySSE(const char *p, Block *b) {
+
+  memset(b, 0, sizeof(Block));
+  for (int i=0; i<4; i++) {
+    __m128i x = _mm_loadu_si128((const __m128i *)(p + i * 16));
+    __m128i lower = _mm_or_si128(x, _mm_set1_epi8(0x20));
+    __m128i op = _mm_or_si128(
+      _mm_or_si128(_mm_cmpeq_epi8(lower, _mm_set1_epi8('{')), _mm_cmpeq_epi8(lower, _mm_set1_epi8('}'))),
+      _mm_or_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8(':')), _mm_cmpeq_epi8(x, _mm_set1_epi8(','))));
+    __m128i ws = _mm_or_si128(
+      _mm_or_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(x, _mm_set1_epi8('\t'))),
+      _mm_or_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(x, _mm_set1_epi8('\r'))));
+    __m128i ctrl = _mm_cmpeq_epi8(_mm_max_epu8(x, _mm_set1_epi8(0x1F)), _mm_set1_epi8(0x1F));
+    int shift = i * 16;
+    b->quote |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(x, _mm_set1_epi8('"'))) << shift;
+    b->backslash |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(x, _mm_set1_epi8('\\'))) << shift;
+    b->op |= (uint64_t)(uint16_t)_mm_movemask_epi8(op) << shift;
+    b->ws |= (uint64_t)(uint16_t)_mm_movemask_epi8(ws) << shift;
+    b->ctrl |= (uint64_t)(uint16_t)_mm_movemask_epi8(ctrl) << shift;
+    b->high |= (uint64_t)(uint16_t)_mm_movemask_epi8(x) << shift;
+  }
+  
+}
+
+__attribute__((target("avx2")))
+void classifyAVX2(const char *p, Block *b) {
+
+  memset(b, 0, sizeof(Block));
+  for (int i=0; i<2; i++) {
+    __m256i x = _mm256_loadu_si256((const __m256i *)(p + i * 32));
+    __m256i lower = _mm256_or_si256(x, _mm256_set1_epi8(0x20));
+    __m256i op = _mm256_or_si256(
+      _mm256_or_si256(_mm256_cmpeq_epi8(lower, _mm256_set1_epi8('{')), _mm256_cmpeq_epi8(lower, _mm256_set1_epi8('}'))),
+      _mm256_or_si256(_mm256_cmpeq_epi8(x, _mm256_set1_epi8(':')), _mm256_cmpeq_epi8(x, _mm256_set1_epi8(','))));
+    __m256i ws = _mm256_or_si256(
+      _mm256_or_si256(_mm256_cmpeq_epi8(x, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(x, _mm256_set1_epi8('\t'))),
+      _mm256_or_si256(_mm256_cmpeq_epi8(x, _mm256_set1_epi8('\n')), _mm256_cmpeq_epi8(x, _mm256_set1_epi8('\r'))));
+    __m256i ctrl = _mm256_cmpeq_epi8(_mm256_max_epu8(x, _mm256_set1_epi8(0x1F)), _mm256_set1_epi8(0x1F));
+    int shift = i * 32;
+    b->quote |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, _mm256_set1_epi8('"'))) << shift;
+    b->backslash |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, _mm256_set1_epi8('\\'))) << shift;
+    b->op |= (uint64_t)(uint32_t)_mm256_movemask_epi8(op) << shift;
+    b->ws |= (uint64_t)(uint32_t)_mm256_movemask_epi8(ws) << shift;
+    b->ctrl |= (uint64_t)(uint32_t)_mm256_movemask_epi8(ctrl) << shift;
+    b->high |= (uint64_t)(uint32_t)_mm256_movemask_epi8(x) << shift;
+  }
+  
+}
+
+// find the first character that has to be escaped in a JSON string, 16 or 32
+// at a time.
+
+__attribute__((target("sse4.2")))
+size_t findEscapeSSE(const char *p, size_t n) {
+
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m128i x = _mm_loadu_si128((const __m128i *)(p + i));
+    __m128i m = _mm_or_si128(
+      _mm_or_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8('"')), _mm_cmpeq_epi8(x, _mm_set1_epi8('\\'))),
+      _mm_cmpeq_epi8(_mm_max_epu8(x, _mm_set1_epi8(0x1F)), _mm_set1_epi8(0x1F)));
+    int bits = _mm_movemask_epi8(m);
+    if (bits) {
+      return i + __builtin_ctz(bits);
+    }
+  }
+  return i + json::findEscapeScalar(std::string_view(p + i, n - i), 0);
+  
+}
+
+__attribute__((target("avx2")))
+size_t findEscapeAVX2(const char *p, size_t n) {
+
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m256i x = _mm256_loadu_si256((const __m256i *)(p + i));
+    __m256i m = _mm256_or_si256(
+      _mm256_or_si256(_mm256_cmpeq_epi8(x, _mm256_set1_epi8('"')), _mm256_cmpeq_epi8(x, _mm256_set1_epi8('\\'))),
+      _mm256_cmpeq_epi8(_mm256_max_epu8(x, _mm256_set1_epi8(0x1F)), _mm256_set1_epi8(0x1F)));
+    uint32_t bits = _mm256_movemask_epi8(m);
+    if (bits) {
+      return i + __builtin_ctz(bits);
+    }
+  }
+  return i + json::findEscapeScalar(std::string_view(p + i, n - i), 0);
+  
+}
+
+// UTF-8 validation with the lookup tables from "Validating UTF-8 In Less Than 
+// One Instruction Per Byte" (Keiser and Lemire), the same as simdjson. Each byte 
+// is checked against the one (and for the length, two and three) before it with 
+// 3 table lookups of a nibble each. A bit in all 3 is an error.
+
+const uint8_t TOO_SHORT = 1 << 0;
+const uint8_t TOO_LONG = 1 << 1;
+const uint8_t OVERLONG_3 = 1 << 2;
+const uint8_t TOO_LARGE = 1 << 3;
+const uint8_t SURROGATE = 1 << 4;
+const uint8_t OVERLONG_2 = 1 << 5;
+const uint8_t TOO_LARGE_1000 = 1 << 6;
+const uint8_t OVERLONG_4 = 1 << 6;
+const uint8_t TWO_CONTS = 1 << 7;
+const uint8_t CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS;
+
+#define DICT_BYTE_1_HIGH \
+  TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, \
+  TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS, \
+  TOO_SHORT | OVERLONG_2, \
+  TOO_SHORT, \
+  TOO_SHORT | OVERLONG_3 | SURROGATE, \
+  TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4
+  
+#define DICT_BYTE_1_LOW \
+  CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4, \
+  CARRY | OVERLONG_2, \
+  CARRY, \
+  CARRY, \
+  CARRY | TOO_LARGE, \
+  CARRY | TOO_LARGE | TOO_LARGE_1000, \
+  CARRY | TOO_LARGE | TOO_LARGE_1000, \
+  CARRY | TOO_LARGE | TOO_LARGE_1000, \
+  CARRY | TOO_LARGE | TOO_LARGE_1000, \
+  CARRY | TOO_LARGE | TOO_LARGE_1000, \
+  CARRY | TOO_LARGE | TOO_LARGE_1000, \
+  CARRY | TOO_LARGE | TOO_LARGE_1000, \
+  CARRY | TOO_LARGE | TOO_LARGE_1000, \
+  CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE, \
+  CARRY | TOO_LARGE | TOO_LARGE_1000, \
+  CARRY | TOO_LARGE | TOO_LARGE_1000
+  
+#define DICT_BYTE_2_HIGH \
+  TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, \
+  TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4, \
+  TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE, \
+  TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE, \
+  TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE, \
+  TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT
+
+__attribute__((target("sse4.2")))
+bool validUTF8SSE(const char *p, size_t n) {
+
+  const __m128i byte1High = _mm_setr_epi8(DICT_BYTE_1_HIGH);
+  const __m128i byte1Low = _mm_setr_epi8(DICT_BYTE_1_LOW);
+  const __m128i byte2High = _mm_setr_epi8(DICT_BYTE_2_HIGH);
+  const __m128i nibble = _mm_set1_epi8(0x0F);
+  // anything bigger than these in the last 3 needs more bytes.
+  const __m128i incompleteMax = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 
+    (char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1));
+  
+  __m128i prev = _mm_setzero_si128();
+  __m128i incomplete = _mm_setzero_si128();
+  __m128i error = _mm_setzero_si128();
+  
+  for (size_t i=0; i<n; i+=16) {
+    __m128i x;
+    if (i + 16 <= n) {
+      x = _mm_loadu_si128((const __m128i *)(p + i));
+    }
+    else {
+      // pad the end with zeros, which are ASCII.
+      char buf[16] = {};
+      memcpy(buf, p + i, n - i);
+      x = _mm_loadu_si128((const __m128i *)buf);
+    }
+    if (_mm_movemask_epi8(x) == 0) {
+      // all ASCII, just make sure the last one finished.
+      error = _mm_or_si128(error, incomplete);
+      prev = x;
+      incomplete = _mm_setzero_si128();
+      continue;
+    }
+    
+    __m128i prev1 = _mm_alignr_epi8(x, prev, 15);
+    __m128i sc = _mm_and_si128(_mm_and_si128(
+      _mm_shuffle_epi8(byte1High, _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble)),
+      _mm_shuffle_epi8(byte1Low, _mm_and_si128(prev1, nibble))),
+      _mm_shuffle_epi8(byte2High, _mm_and_si128(_mm_srli_epi16(x, 4), nibble)));
+      
+    // the third and fourth bytes of 3 and 4 byte sequences must be continuations.
+    __m128i prev2 = _mm_alignr_epi8(x, prev, 14);
+    __m128i prev3 = _mm_alignr_epi8(x, prev, 13);
+    __m128i must23 = _mm_or_si128(_mm_subs_epu8(prev2, _mm_set1_epi8((char)(0xE0 - 0x80))), 
+      _mm_subs_epu8(prev3, _mm_set1_epi8((char)(0xF0 - 0x80))));
+    __m128i must23_80 = _mm_and_si128(must23, _mm_set1_epi8((char)0x80));
+    error = _mm_or_si128(error, _mm_xor_si128(must23_80, sc));
+    
+    incomplete = _mm_subs_epu8(x, incompleteMax);
+    prev = x;
+  }
+  error = _mm_or_si128(error, incomplete);
+  return _mm_testz_si128(error, error);
+  
+}
+
+__attribute__((target("avx2")))
+bool validUTF8AVX2(const char *p, size_t n) {
+
+  const __m256i byte1High = _mm256_setr_epi8(DICT_BYTE_1_HIGH, DICT_BYTE_1_HIGH);
+  const __m256i byte1Low = _mm256_setr_epi8(DICT_BYTE_1_LOW, DICT_BYTE_1_LOW);
+  const __m256i byte2High = _mm256_setr_epi8(DICT_BYTE_2_HIGH, DICT_BYTE_2_HIGH);
+  const __m256i nibble = _mm256_set1_epi8(0x0F);
+  const __m256i incompleteMax = _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 
+    (char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1));
+  
+  __m256i prev = _mm256_setzero_si256();
+  __m256i incomplete = _mm256_setzero_si256();
+  __m256i error = _mm256_setzero_si256();
+  
+  for (size_t i=0; i<n; i+=32) {
+    __m256i x;
+    if (i + 32 <= n) {
+      x = _mm256_loadu_si256((const __m256i *)(p + i));
+    }
+    else {
+      char buf[32] = {};
+      memcpy(buf, p + i, n - i);
+      x = _mm256_loadu_si256((const __m256i *)buf);
+    }
+    if (_mm256_movemask_epi8(x) == 0) {
+      error = _mm256_or_si256(error, incomplete);
+      prev = x;
+      incomplete = _mm256_setzero_si256();
+      continue;
+    }
+    
+    // alignr works on each 128 bit lane, so line up the high half of prev
+    // and the low half of x first.
+    __m256i shifted = _mm256_permute2x128_si256(prev, x, 0x21);
+    __m256i prev1 = _mm256_alignr_epi8(x, shifted, 15);
+    __m256i sc = _mm256_and_si256(_mm256_and_si256(
+      _mm256_shuffle_epi8(byte1High, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble)),
+      _mm256_shuffle_epi8(byte1Low, _mm256_and_si256(prev1, nibble))),
+      _mm256_shuffle_epi8(byte2High, _mm256_and_si256(_mm256_srli_epi16(x, 4), nibble)));
+      
+    __m256i prev2 = _mm256_alignr_epi8(x, shifted, 14);
+    __m256i prev3 = _mm256_alignr_epi8(x, shifted, 13);
+    __m256i must23 = _mm256_or_si256(_mm256_subs_epu8(prev2, _mm256_set1_epi8((char)(0xE0 - 0x80))), 
+      _mm256_subs_epu8(prev3, _mm256_set1_epi8((char)(0xF0 - 0x80))));
+    __m256i must23_80 = _mm256_and_si256(must23, _mm256_set1_epi8((char)0x80));
+    error = _mm256_or_si256(error, _mm256_xor_si256(must23_80, sc));
+    
+    incomplete = _mm256_subs_epu8(x, incompleteMax);
+    prev = x;
+  }
+  error = _mm256_or_si256(error, incomplete);
+  return _mm256_testz_si256(error, error);
+  
+}
+
+#endif
+
+size_t findEscapeScalar(const char *p, size_t n) {
+  return json::findEscapeScalar(std::string_view(p, n), 0);
+}
+
+bool validUTF8Scalar(const char *p, size_t n) {
+  return json::validUTF8Scalar(std::string_view(p, n));
+}
+
+struct Kernel {
+  const char *name;
+  Classify classify;
+  size_t (*findEscape)(const char *p, size_t n);
+  bool (*validUTF8)(const char *p, size_t n);
+};
+
+const Kernel scalarKernel = { "scalar", classifyScalar, findEscapeScalar, validUTF8Scalar };
+#ifdef DICT_X86
+const Kernel sseKernel = { "sse4.2", classifySSE, findEscapeSSE, validUTF8SSE };
+const Kernel avx2Kernel = { "avx2", classifyAVX2, findEscapeAVX2, validUTF8AVX2 };
+#endif
+
+const Kernel *bestKernel() {
+
+#ifdef DICT_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return &avx2Kernel;
+  }
+  if (__builtin_cpu_supports("sse4.2")) {
+    return &sseKernel;
+  }
+#endif
+  return &scalarKernel;
+  
+}
+
+std::atomic<const Kernel *> &kernel() {
+
+  // other threads can be parsing while it's changed, so it only ever
+  // points at one of the tables.
+  static std::atomic<const Kernel *> k(bestKernel());
+  return k;
+  
+}
+
+uint64_t prefixXor(uint64_t x) {
+
+  x ^= x << 1;
+  x ^= x << 2;
+  x ^= x << 4;
+  x ^= x << 8;
+  x ^= x << 16;
+  x ^= x << 32;
+  return x;
+  
+}
+
+uint64_t findEscaped(uint64_t backslash, uint64_t *prevEscaped) {
+
+  // straight out of simdjson. A character is escaped if it follows an odd
+  // length run of backslashes.
+  backslash &= ~*prevEscaped;
+  uint64_t followsEscape = backslash << 1 | *prevEscaped;
+  const uint64_t evenBits = 0x5555555555555555ULL;
+  uint64_t oddSequenceStarts = backslash & ~evenBits & ~followsEscape;
+  uint64_t sequencesStartingOnEvenBits;
+  *prevEscaped = __builtin_add_overflow(oddSequenceStarts, backslash, &sequencesStartingOnEvenBits);
+  uint64_t invertMask = sequencesStartingOnEvenBits << 1;
+  return (evenBits ^ invertMask) & followsEscape;
+  
+}
+
+} // namespace
+
+size_t json::findEscape(std::string_view s, size_t i) {
+
+  if (i >= s.size()) {
+    return s.size();
+  }
+  return i + kernel().load()->findEscape(s.data() + i, s.size() - i);
+  
+}
+
+bool json::validUTF8(std::string_view s) {
+
+  return kernel().load()->validUTF8(s.data(), s.size());
+  
+}
+
+const char *json::structuralIndex(std::string_view s, std::vector<uint32_t> *index) {
+
+  uint64_t prevEscaped = 0;
+  uint64_t prevInString = 0;
+  uint64_t prevScalar = 0;
+  std::optional<size_t> firstHigh;
+  auto classify = kernel().load()->classify;
+  
+  index->reserve(s.size() / 8 + 1);
+  
+  for (size_t base=0; base<s.size(); base+=64) {
+  
+    Block b;
+    size_t left = s.size() - base;
+    if (left >= 64) {
+      classify(s.data() + base, &b);
+    }
+    else {
+      // pad the end out with spaces.
+      char buf[64];
+      memset(buf, ' ', sizeof(buf));
+      memcpy(buf, s.data() + base, left);
+      classify(buf, &b);
+    }
+    
+    if (b.high && !firstHigh) {
+      firstHigh = base;
+    }
+    
+    uint64_t escaped = findEscaped(b.backslash, &prevEscaped);
+    uint64_t quote = b.quote & ~escaped;
+    uint64_t inString = prefixXor(quote) ^ prevInString;
+    prevInString = (uint64_t)((int64_t)inString >> 63);
+    
+    if (b.ctrl & inString) {
+      return "control character in string";
+    }
+    
+    uint64_t scalar = ~(b.op | b.ws | quote | inString);
+    uint64_t scalarStart = scalar & ~(scalar << 1 | prevScalar);
+    prevScalar = scalar >> 63;
+    
+    // the opening quotes are in the string, the closing ones aren't.
+    uint64_t structural = (b.op & ~inString) | (quote & inString) | scalarStart;
+    if (left < 64) {
+      structural &= (1ULL << left) - 1;
+    }
+    
+    while (structural) {
+      index->push_back(base + __builtin_ctzll(structural));
+      structural &= structural - 1;
+    }
+  }
+  
+  if (prevInString) {
+    return "unterminated string";
+  }
+  
+  // everything before the first non ASCII block is fine.
+  if (firstHigh && !json::validUTF8(s.substr(*firstHigh))) {
+    return "invalid UTF-8";
+  }
+  
+  return nullptr;
+  
+}
+
+bool json::index(std::string_view s, std::vector<uint32_t> *index) {
+
+  if (s.size() > UINT32_MAX) {
+    BOOST_LOG_TRIVIAL(error) << "JSON too big for the SIMD parser";
+    return false;
+  }
+  
+  auto err = structuralIndex(s, index);
+  if (err) {
+    BOOST_LOG_TRIVIAL(error) << "could not parse JSON: " << err;
+    return false;
+  }
+  return true;
+  
+}
+
+bool json::fail(std::string_view s, const std::vector<uint32_t> &index, size_t n, const std::string &msg) {
+
+  BOOST_LOG_TRIVIAL(error) << "could not parse JSON at " << (n < index.size() ? index[n] : s.size()) << ": " << msg;
+  return false;
+  
+}
+
+namespace {
+
+class GBuilder {
+
+  // build a DictG.
+  
+public:
+  typedef DictG Value;
+  typedef DictO Object;
+  typedef DictV Vector;
+  typedef std::string Key;
+  
+  Object beginObject() { return Object(); }
+  Key key(std::string_view k) { return Key(k); }
+  void member(Object &o, Key &&k, Value &&v) { o.insert(std::move(k), std::move(v)); }
+  void endObject(Object &o, Value *out) { *out = DictG(std::move(o)); }
+  Vector beginVector() { return Vector(); }
+  void element(Vector &v, Value &&e) { v.push_back(std::move(e)); }
+  void endVector(Vector &v, Value *out) { *out = DictG(std::move(v)); }
+  void string(std::string_view s, Value *out) { *out = DictG(std::string(s)); }
+  void number(const json::Number &n, Value *out) { *out = n.integer ? DictG(n.num) : DictG(n.d); }
+  void boolean(bool b, Value *out) { *out = DictG(b); }
+  void null(Value *out) { *out = DictG(); }
+  
+};
+
+} // namespace
+
+bool json::build(std::string_view s, const std::vector<uint32_t> &index, size_t *n, DictG *out) {
+
+  GBuilder builder;
+  Parser<GBuilder> parser(s, index, builder, *n);
+  return parser.parseValue(out, n);
+  
+}
+
+std::optional<DictG> Dict::parseSimd(std::string_view s) {
+
+  std::vector<uint32_t> index;
+  if (!json::index(s, &index)) {
+    return std::nullopt;
+  }
+  
+  DictG g;
+  GBuilder builder;
+  json::Parser<GBuilder> parser(s, index, builder);
+  if (!parser.parse(&g)) {
+    return std::nullopt;
+  }
+  return g;
+  
+}
+
+std::string Dict::simdKernel() {
+
+  return kernel().load()->name;
+  
+}
+
+bool Dict::setSimdKernel(const std::string &name) {
+
+  if (name == "scalar") {
+    kernel() = &scalarKernel;
+    return true;
+  }
+#ifdef DICT_X86
+  if (name == "sse4.2" && __builtin_cpu_supports("sse4.2")) {
+    kernel() = &sseKernel;
+    return true;
+  }
+  if (name == "avx2" && __builtin_cpu_supports("avx2")) {
+    kernel() = &avx2Kernel;
+    return true;
+  }
+#endif
+  BOOST_LOG_TRIVIAL(error) << "SIMD kernel " << name << " not supported";
+  return false;
+  
+}
@@ -0,0 +1,191 @@
+/*
+  dictstream.cpp
+  
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+  
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+ 
+  https://github.com/visualopsholdings/dict
+*/
+
+#include "dict.hpp"
+#include "dictcodec.hpp"
+
+#include <boost/log/trivial.hpp>
+#include <istream>
+
+using namespace vops;
+
+namespace {
+
+class ArrayReader {
+
+  // Reads the stream a chunk at a time and finds where each element
+  // of the array ends by keeping track of the brackets and strings. The
+  // elements that are done are thrown away from the buffer when the next
+  // chunk is read.
+  
+public:
+  ArrayReader(std::istream &s, size_t chunk): _s(s), _chunk(chunk), _json(DictCodec::get(".json")) {}
+  
+  bool read(std::function<bool (DictG &&)> callback);
+  
+private:
+  bool more();
+  bool skipWS();
+  bool fail(const std::string &msg);
+  
+  std::istream &_s;
+  size_t _chunk;
+  std::shared_ptr<const DictCodec> _json;
+  std::string _buf;
+  size_t _pos = 0;
+  size_t _mark = 0;
+    // everything before this is done with.
+  size_t _read = 0;
+    // how much we have thrown away.
+  
+};
+
+bool ArrayReader::more() {
+
+  if (!_s) {
+    return false;
+  }
+  
+  // throw away what's done, it's only ever moved once.
+  if (_mark > 0) {
+    _buf.erase(0, _mark);
+    _read += _mark;
+    _pos -= _mark;
+    _mark = 0;
+  }
+  
+  auto size = _buf.size();
+  _buf.resize(size + _chunk);
+  _s.read(_buf.data() + size, _chunk);
+  _buf.resize(size + _s.gcount());
+  return _buf.size() > size;
+  
+}
+
+bool ArrayReader::skipWS() {
+
+  while (true) {
+    while (_pos < _buf.size() && (_buf[_pos] == ' ' || _buf[_pos] == '\n' || _buf[_pos] == '\t' || _buf[_pos] == '\r')) {
+      _pos++;
+    }
+    if (_pos < _buf.size()) {
+      return true;
+    }
+    if (!more()) {
+      return false;
+    }
+  }
+  
+}
+
+bool ArrayReader::fail(const std::string &msg) {
+
+  BOOST_LOG_TRIVIAL(error) << "could not parse JSON array at " << _read + _pos << ": " << msg;
+  return false;
+  
+}
+
+bool ArrayReader::read(std::function<bool (DictG &&)> callback) {
+
+  if (!skipWS() || _buf[_pos] != '[') {
+    return fail("expected [");
+  }
+  _pos++;
+  
+  if (!skipWS()) {
+    return fail("unexpected end");
+  }
+  bool empty = _buf[_pos] == ']';
+  if (empty) {
+    _pos++;
+  }
+  
+  while (!empty) {
+  
+    // everything before this element is done with.
+    _mark = _pos;
+    
+    if (!skipWS()) {
+      return fail("unexpected end");
+    }
+    _mark = _pos;
+    
+    int depth = 0;
+    bool inString = false;
+    bool escape = false;
+    bool last = false;
+    while (true) {
+      if (_pos >= _buf.size() && !more()) {
+        return fail("unexpected end");
+      }
+      char c = _buf[_pos];
+      if (inString) {
+        if (escape) {
+          escape = false;
+        }
+        else if (c == '\\') {
+          escape = true;
+        }
+        else if (c == '"') {
+          inString = false;
+        }
+      }
+      else if (c == '"') {
+        inString = true;
+      }
+      else if (c == '{' || c == '[') {
+        depth++;
+      }
+      else if (c == '}' || c == ']') {
+        if (depth == 0) {
+          if (c == '}') {
+            return fail("unexpected }");
+          }
+          last = true;
+          break;
+        }
+        depth--;
+      }
+      else if (c == ',' && depth == 0) {
+        break;
+      }
+      _pos++;
+    }
+    
+    auto g = _json->parse(std::string_view(_buf).substr(_mark, _pos - _mark));
+    if (!g) {
+      return fail("invalid element");
+    }
+    _pos++;
+    if (!callback(std::move(*g))) {
+      return true;
+    }
+    if (last) {
+      break;
+    }
+  }
+  
+  // there can't be anything after it.
+  if (skipWS()) {
+    return fail("extra characters at the end");
+  }
+  return true;
+  
+}
+
+}
+
+bool Dict::streamArray(std::istream &s, std::function<bool (DictG &&)> callback, size_t chunk) {
+
+  ArrayReader reader(s, chunk);
+  return reader.read(callback);
+  
+}
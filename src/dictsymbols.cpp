@@ -0,0 +1,139 @@
+/*
+  dictsymbols.cpp
+  
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+  
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+ 
+  https://github.com/visualopsholdings/dict
+*/
+
+#include "dictsymbols.hpp"
+
+using namespace vops;
+
+Symbol::Symbol(std::string_view s): Symbol(Symbols::global().intern(s)) {
+}
+
+Symbol::Symbol(const Symbol &other): _e(other._e) {
+
+  if (_e) {
+    _e->refs.fetch_add(1, std::memory_order_relaxed);
+  }
+  
+}
+
+Symbol &Symbol::operator=(const Symbol &other) {
+
+  if (other._e) {
+    other._e->refs.fetch_add(1, std::memory_order_relaxed);
+  }
+  if (_e) {
+    _e->symbols->release(_e);
+  }
+  _e = other._e;
+  return *this;
+  
+}
+
+Symbol &Symbol::operator=(Symbol &&other) noexcept {
+
+  if (this != &other) {
+    if (_e) {
+      _e->symbols->release(_e);
+    }
+    _e = other._e;
+    other._e = nullptr;
+  }
+  return *this;
+  
+}
+
+Symbol::~Symbol() {
+
+  if (_e) {
+    _e->symbols->release(_e);
+  }
+  
+}
+
+Symbol Symbols::intern(std::string_view s) {
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  
+  auto found = _symbols.find(s);
+  if (found != _symbols.end()) {
+    found->second->refs.fetch_add(1, std::memory_order_relaxed);
+    return Symbol(found->second.get());
+  }
+  auto e = std::make_unique<Symbol::Entry>(std::string(s), 1, this);
+  auto p = e.get();
+  _symbols.emplace(p->s, std::move(e));
+  return Symbol(p);
+  
+}
+
+std::optional<Symbol> Symbols::find(std::string_view s) const {
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  
+  auto found = _symbols.find(s);
+  if (found == _symbols.end()) {
+    return std::nullopt;
+  }
+  found->second->refs.fetch_add(1, std::memory_order_relaxed);
+  return Symbol(found->second.get());
+  
+}
+
+void Symbols::release(Symbol::Entry *e) {
+
+  // only the last one needs the lock. Interning takes it too, so nobody can
+  // pick the key up again while it's going.
+  auto refs = e->refs.load(std::memory_order_relaxed);
+  while (refs > 1) {
+    if (e->refs.compare_exchange_weak(refs, refs - 1, std::memory_order_acq_rel)) {
+      return;
+    }
+  }
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (e->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    _symbols.erase(_symbols.find(e->s));
+  }
+  
+}
+
+size_t Symbols::size() const {
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  
+  return _symbols.size();
+  
+}
+
+size_t Symbols::bytes() const {
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  
+  // each node in the map has the key, the pointer and a next pointer, and
+  // there is a bucket for it and the entry it points to.
+  size_t total = _symbols.bucket_count() * sizeof(void *);
+  for (auto &s: _symbols) {
+    total += sizeof(std::string_view) + sizeof(void *) * 2 + sizeof(Symbol::Entry);
+    if (s.second->s.capacity() > 15) {
+      total += s.second->s.capacity() + 1;
+    }
+  }
+  return total;
+  
+}
+
+Symbols &Symbols::global() {
+
+  // never destroyed, since anything static might still have symbols
+  // when the program ends.
+  static Symbols *symbols = new Symbols();
+  return *symbols;
+  
+}
@@ -0,0 +1,476 @@
+/*
+  dicttape.cpp
+  
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+  
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+ 
+  https://github.com/visualopsholdings/dict
+*/
+
+#include "dicttape.hpp"
+#include "dictjson.hpp"
+
+#include <boost/log/trivial.hpp>
+#include <unordered_map>
+#include <climits>
+
+using namespace vops;
+
+namespace vops {
+
+class TapeBuilder {
+
+  // write the JSON parser's values straight onto the tape. Everything is 
+  // already on the tape in order, so the values themselves are nothing.
+  
+public:
+  TapeBuilder(DictTape *tape): _tape(tape) {}
+  
+  struct Value {};
+  struct Key {};
+  struct Object {
+    size_t start;
+    uint32_t n;
+  };
+  typedef Object Vector;
+  
+  Object beginObject() { return { push(DictTape::Type::Object, 0, 0), 0 }; }
+  Key key(std::string_view k);
+  void member(Object &o, Key &&, Value &&) { o.n++; }
+  void endObject(Object &o, Value *) { end(o); }
+  Vector beginVector() { return { push(DictTape::Type::Vector, 0, 0), 0 }; }
+  void element(Vector &v, Value &&) { v.n++; }
+  void endVector(Vector &v, Value *) { end(v); }
+  void string(std::string_view s, Value *);
+  void number(const json::Number &n, Value *);
+  void boolean(bool b, Value *) { push(DictTape::Type::Bool, 0, b ? 1 : 0); }
+  void null(Value *) { push(DictTape::Type::Null, 0, 0); }
+  
+private:
+  struct Hash {
+    using is_transparent = void;
+    size_t operator()(std::string_view s) const { return std::hash<std::string_view>()(s); }
+  };
+  
+  size_t push(DictTape::Type type, uint32_t len, int64_t num);
+  void end(const Object &o);
+  
+  DictTape *_tape;
+  std::unordered_map<std::string, std::pair<uint64_t, uint32_t>, Hash, std::equal_to<>> _keys;
+    // keys are only stored once.
+  
+};
+
+}
+
+std::optional<DictTape> Dict::parseTape(const std::string &s) {
+
+  std::vector<uint32_t> index;
+  if (!json::index(s, &index)) {
+    return std::nullopt;
+  }
+  
+  DictTape tape;
+  
+  // one entry for everything in the index except the closing brackets, colons
+  // and commas, so it's exactly the right size.
+  size_t entries = 0;
+  for (auto i: index) {
+    auto c = s[i];
+    entries += c != '}' && c != ']' && c != ':' && c != ',';
+  }
+  tape._tape.reserve(entries);
+  
+  TapeBuilder builder(&tape);
+  json::Parser<TapeBuilder> parser(s, index, builder);
+  TapeBuilder::Value v;
+  if (!parser.parse(&v)) {
+    return std::nullopt;
+  }
+  return tape;
+  
+}
+
+size_t TapeBuilder::push(DictTape::Type type, uint32_t len, int64_t num) {
+
+  DictTape::Entry e;
+  e.type = type;
+  e.len = len;
+  e.num = num;
+  _tape->_tape.push_back(e);
+  return _tape->_tape.size() - 1;
+  
+}
+
+void TapeBuilder::end(const Object &o) {
+
+  auto &e = _tape->_tape[o.start];
+  e.len = o.n;
+  e.off = _tape->_tape.size();
+  
+}
+
+TapeBuilder::Key TapeBuilder::key(std::string_view k) {
+
+  auto found = _keys.find(k);
+  if (found != _keys.end()) {
+    push(DictTape::Type::String, found->second.second, found->second.first);
+    return {};
+  }
+  
+  auto off = _tape->_strings.size();
+  _tape->_strings.append(k);
+  _keys.emplace(k, std::make_pair(off, k.size()));
+  push(DictTape::Type::String, k.size(), off);
+  return {};
+  
+}
+
+void TapeBuilder::string(std::string_view s, Value *) {
+
+  auto off = _tape->_strings.size();
+  _tape->_strings.append(s);
+  push(DictTape::Type::String, s.size(), off);
+  
+}
+
+void TapeBuilder::number(const json::Number &n, Value *) {
+
+  if (n.integer) {
+    push(DictTape::Type::Num, 0, n.num);
+    return;
+  }
+  auto i = push(DictTape::Type::Double, 0, 0);
+  _tape->_tape[i].d = n.d;
+  
+}
+
+size_t DictTape::bytes() const {
+
+  return _tape.capacity() * sizeof(Entry) + _strings.capacity();
+  
+}
+
+size_t DictTape::next(size_t i) const {
+
+  auto &e = _tape[i];
+  if (e.type == Type::Object || e.type == Type::Vector) {
+    return e.off;
+  }
+  return i + 1;
+  
+}
+
+std::string_view DictTape::str(size_t i) const {
+
+  return std::string_view(_strings.data() + _tape[i].off, _tape[i].len);
+  
+}
+
+std::optional<size_t> DictTape::member(size_t i, std::string_view key) const {
+
+  auto end = _tape[i].off;
+  for (i++; i < end; i = next(i + 1)) {
+    if (str(i) == key) {
+      return i + 1;
+    }
+  }
+  return std::nullopt;
+  
+}
+
+std::optional<size_t> DictTape::element(size_t i, size_t index) const {
+
+  if (index >= _tape[i].len) {
+    return std::nullopt;
+  }
+  for (i++; index > 0; index--) {
+    i = next(i);
+  }
+  return i;
+  
+}
+
+std::optional<DictTape::Node> DictTape::find_pointer(const Dict::Pointer &path) const {
+
+  if (!path.valid()) {
+    return std::nullopt;
+  }
+
+  size_t i = 0;
+  for (auto &t: path) {
+    auto &e = _tape[i];
+    if (e.type == Type::Object) {
+      auto m = member(i, t.key);
+      if (!m) {
+        BOOST_LOG_TRIVIAL(error) << t.key << " not found";
+        return std::nullopt;
+      }
+      i = *m;
+      continue;
+    }
+    if (e.type != Type::Vector) {
+      BOOST_LOG_TRIVIAL(error) << "only objects and vectors supported";
+      return std::nullopt;
+    }
+    auto el = t.index ? element(i, *t.index) : std::nullopt;
+    if (!el) {
+      BOOST_LOG_TRIVIAL(error) << "invalid index " << t.key;
+      return std::nullopt;
+    }
+    i = *el;
+  }
+  
+  return Node(this, i);
+  
+}
+
+std::optional<DictTape::Node> DictTape::find_pointer(const std::string &path) const {
+
+  return find_pointer(Dict::Pointer(path));
+  
+}
+
+DictTape::Node::Node(const Node &prev, size_t i, std::string_view key): 
+  _tape(prev._tape), _i(i), _path(prev._path) {
+  
+  _path += "/";
+  _path += key;
+  
+}
+
+DictTape::Node::Node(const Node &prev, const std::string &err): 
+  _tape(nullptr), _i(0), _path(prev._path), _err(err) {
+}
+
+DictTape::Type DictTape::Node::type() const {
+
+  if (!has_value()) {
+    return Type::Null;
+  }
+  return _tape->_tape[_i].type;
+  
+}
+
+std::optional<std::string_view> DictTape::Node::getStringView() const {
+
+  if (type() != Type::String) {
+    return std::nullopt;
+  }
+  return _tape->str(_i);
+  
+}
+
+std::optional<long long> DictTape::Node::getNum() const {
+
+  if (type() != Type::Num) {
+    return std::nullopt;
+  }
+  return _tape->_tape[_i].num;
+  
+}
+
+std::optional<bool> DictTape::Node::getBool() const {
+
+  if (type() != Type::Bool) {
+    return std::nullopt;
+  }
+  return _tape->_tape[_i].num != 0;
+  
+}
+
+std::optional<std::string_view> DictTape::Node::getFirstKey() const {
+
+  if (type() != Type::Object || _tape->_tape[_i].len == 0) {
+    return std::nullopt;
+  }
+  return _tape->str(_i + 1);
+  
+}
+
+DictTape::Node DictTape::Node::object(std::string_view key) const {
+
+  if (!has_value()) {
+    BOOST_LOG_TRIVIAL(trace) << "unwinding error";
+    return *this;
+  }
+  
+  if (type() != Type::Object) {
+    return Node(*this, "Err: Dict is not an object");
+  }
+  
+  auto m = _tape->member(_i, key);
+  if (!m) {
+    return Node(*this, "Err: " + std::string(key) + " not found");
+  }
+  
+  return Node(*this, *m, key);
+  
+}
+
+DictTape::Node DictTape::Node::vector(int index) const {
+
+  if (!has_value()) {
+    BOOST_LOG_TRIVIAL(trace) << "unwinding error";
+    return *this;
+  }
+  
+  if (type() != Type::Vector) {
+    return Node(*this, "Err: Dict is not a vector");
+  }
+  
+  auto el = index < 0 ? std::nullopt : _tape->element(_i, index);
+  if (!el) {
+    return Node(*this, "Err: index " + std::to_string(index) + " is invalid");
+  }
+  
+  return Node(*this, *el, std::to_string(index));
+  
+}
+
+std::string DictTape::Node::string() const {
+
+  if (!has_value()) {
+    BOOST_LOG_TRIVIAL(trace) << "unwinding error";
+    return *error();
+  }
+  
+  auto str = getStringView();
+  if (!str) {
+    return "Err: not a string";
+  }
+  
+  return std::string(*str);
+  
+}
+
+bool DictTape::Node::boolean() const {
+
+  auto b = getBool();
+  if (!b) {
+    return false;
+  }
+  return *b;
+  
+}
+
+long long DictTape::Node::num() const {
+
+  auto l = getNum();
+  if (!l) {
+    return 0;
+  }
+  return *l;
+  
+}
+
+int DictTape::Node::size() const {
+
+  if (!has_value()) {
+    BOOST_LOG_TRIVIAL(trace) << "unwinding error";
+    return *errori();
+  }
+  
+  if (type() != Type::Vector) {
+    BOOST_LOG_TRIVIAL(trace) << "underlying error is Err: not a vector";
+    return INT_MAX;
+  }
+  
+  return _tape->_tape[_i].len;
+  
+}
+
+std::optional<std::string> DictTape::Node::error() const {
+
+  if (has_value()) {
+    return std::nullopt;
+  }
+  
+  if (_path.empty()) {
+    return _err;
+  }
+  return "Path: " + _path + " " + _err;
+  
+}
+
+std::optional<int> DictTape::Node::errori() const {
+
+  if (has_value()) {
+    return std::nullopt;
+  }
+  
+  BOOST_LOG_TRIVIAL(trace) << *error();
+  
+  return INT_MAX;
+  
+}
+
+DictTape::Node::const_iterator DictTape::Node::begin() const {
+
+  auto t = type();
+  if (t != Type::Object && t != Type::Vector) {
+    return end();
+  }
+  return const_iterator(_tape, _i + 1, t == Type::Object);
+  
+}
+
+DictTape::Node::const_iterator DictTape::Node::end() const {
+
+  auto t = type();
+  if (t != Type::Object && t != Type::Vector) {
+    return const_iterator(_tape, 0, false);
+  }
+  return const_iterator(_tape, _tape->_tape[_i].off, false);
+  
+}
+
+DictG DictTape::Node::toG() const {
+
+  if (!has_value()) {
+    return DictG();
+  }
+  
+  auto &e = _tape->_tape[_i];
+  switch (e.type) {
+  
+  case Type::Null:
+    return DictG();
+    
+  case Type::Bool:
+    return DictG(e.num != 0);
+    
+  case Type::Num:
+    return DictG(e.num);
+    
+  case Type::Double:
+    return DictG(e.d);
+    
+  case Type::String:
+    return DictG(std::string(_tape->str(_i)));
+    
+  case Type::Object:
+    {
+      DictO o;
+      for (auto i = begin(); i != end(); ++i) {
+        o.insert(std::string(i.key()), (*i).toG());
+      }
+      return o;
+    }
+    
+  case Type::Vector:
+    {
+      DictV v;
+      v.reserve(e.len);
+      for (auto i: *this) {
+        v.push_back(i.toG());
+      }
+      return v;
+    }
+  }
+  
+  return DictG();
+  
+}
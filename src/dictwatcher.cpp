@@ -0,0 +1,218 @@
+/*
+  dictwatcher.cpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+
+  https://github.com/visualopsholdings/dict
+*/
+
+#include "dictwatcher.hpp"
+
+#include <boost/log/trivial.hpp>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+using namespace vops;
+namespace fs = std::filesystem;
+
+DictWatcher::DictWatcher(const std::string &fn, Changed changed, bool silentinclude):
+  _includes(silentinclude), _changed(changed) {
+
+  auto g = Dict::parseFile(fn, _includes);
+  if (g) {
+    _doc = std::make_shared<const DictG>(std::move(*g));
+    _version++;
+  }
+
+#ifdef __linux__
+  _fd = inotify_init1(IN_CLOEXEC);
+  _stopfd = eventfd(0, EFD_CLOEXEC);
+  if (_fd < 0 || _stopfd < 0) {
+    BOOST_LOG_TRIVIAL(error) << "couldn't start inotify, polling instead";
+    if (_fd >= 0) {
+      close(_fd);
+      _fd = -1;
+    }
+  }
+  else {
+    watch();
+  }
+#endif
+
+  _thread = std::thread([this]() { run(); });
+
+}
+
+DictWatcher::~DictWatcher() {
+
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stop = true;
+  }
+  _cond.notify_all();
+#ifdef __linux__
+  if (_stopfd >= 0) {
+    uint64_t one = 1;
+    if (write(_stopfd, &one, sizeof(one)) < 0) {
+      BOOST_LOG_TRIVIAL(error) << "couldn't stop watching";
+    }
+  }
+#endif
+  _thread.join();
+#ifdef __linux__
+  if (_fd >= 0) {
+    close(_fd);
+  }
+  if (_stopfd >= 0) {
+    close(_stopfd);
+  }
+#endif
+
+}
+
+std::shared_ptr<const DictG> DictWatcher::get() const {
+
+  std::lock_guard<std::mutex> lock(_docMutex);
+  return _doc;
+
+}
+
+void DictWatcher::reload() {
+
+  bool changed;
+  if (_includes.reload(&changed) && changed) {
+    auto doc = std::make_shared<const DictG>(std::move(*_includes.release()));
+    {
+      std::lock_guard<std::mutex> lock(_docMutex);
+      _doc = doc;
+    }
+    _version++;
+    if (_changed) {
+      _changed(doc);
+    }
+  }
+
+}
+
+void DictWatcher::run() {
+
+#ifdef __linux__
+  if (_fd >= 0) {
+    pollfd fds[2] = { { _fd, POLLIN, 0 }, { _stopfd, POLLIN, 0 } };
+    alignas(inotify_event) char buf[4096];
+    bool pending = false;
+    while (true) {
+      // editors often write a file in a few goes, so wait for it to go quiet.
+      int n = poll(fds, 2, pending ? 50 : -1);
+      if (n < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        BOOST_LOG_TRIVIAL(error) << "poll failed " << errno;
+        return;
+      }
+      if (fds[1].revents) {
+        return;
+      }
+      if (n == 0) {
+        pending = false;
+        for (auto &f: _pending) {
+          _includes.invalidate(f);
+        }
+        _pending.clear();
+        reload();
+        watch();
+        continue;
+      }
+      auto len = read(_fd, buf, sizeof(buf));
+      for (char *p = buf; p < buf + len; ) {
+        auto e = (const inotify_event *)p;
+        if (e->mask & IN_Q_OVERFLOW) {
+          // we lost some, so look at everything.
+          for (auto &f: _includes.files()) {
+            _pending.insert(f.first);
+          }
+          pending = true;
+        }
+        else if (e->len > 0) {
+          auto f = relevant(e->wd, e->name);
+          if (f) {
+            _pending.insert(*f);
+            pending = true;
+          }
+        }
+        p += sizeof(inotify_event) + e->len;
+      }
+    }
+  }
+#endif
+
+  std::unique_lock<std::mutex> lock(_mutex);
+  while (!_cond.wait_for(lock, std::chrono::seconds(1), [this]() { return _stop; })) {
+    lock.unlock();
+    reload();
+    lock.lock();
+  }
+
+}
+
+std::optional<std::string> DictWatcher::relevant(int wd, const char *name) {
+
+  auto dir = _dirs.find(wd);
+  if (dir == _dirs.end()) {
+    return std::nullopt;
+  }
+  auto fn = (fs::path(dir->second) / name).string();
+  auto &files = _includes.files();
+  if (files.find(fn) == files.end() && !_includes.missing().contains(fn)) {
+    return std::nullopt;
+  }
+  return fn;
+
+}
+
+void DictWatcher::watch() {
+
+#ifdef __linux__
+  // watch the directories rather than the files, since a lot of editors
+  // save by writing a new file and renaming it over the old one.
+  std::set<std::string> dirs;
+  for (auto &f: _includes.files()) {
+    dirs.insert(fs::path(f.first).parent_path().string());
+  }
+  // and where the ones that aren't there yet will turn up.
+  for (auto &m: _includes.missing()) {
+    auto d = fs::path(m).parent_path();
+    if (fs::is_directory(d)) {
+      dirs.insert(d.string());
+    }
+  }
+
+  for (auto i = _dirs.begin(); i != _dirs.end(); ) {
+    if (dirs.find(i->second) == dirs.end()) {
+      inotify_rm_watch(_fd, i->first);
+      i = _dirs.erase(i);
+    }
+    else {
+      i++;
+    }
+  }
+  for (auto &d: dirs) {
+    int wd = inotify_add_watch(_fd, d.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE | IN_MOVED_FROM);
+    if (wd < 0) {
+      BOOST_LOG_TRIVIAL(error) << "couldn't watch " << d;
+      continue;
+    }
+    _dirs[wd] = d;
+  }
+#endif
+
+}
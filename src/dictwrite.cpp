@@ -0,0 +1,396 @@
+/*
+  dictwrite.cpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+
+  Write out a DictG a chunk at a time.
+
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+
+  https://github.com/visualopsholdings/dict
+*/
+
+#include "dict.hpp"
+#include "dictjson.hpp"
+#include "dictcodec.hpp"
+
+#include <boost/log/trivial.hpp>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+using namespace vops;
+
+namespace vops {
+
+class Writer {
+
+public:
+  Writer(std::span<char> buffer, const Dict::Sink &sink): _buffer(buffer), _sink(sink) {}
+
+  bool json(const DictG &g, bool pretty, int indent);
+  bool yaml(const DictG &g, int indent, bool inlined);
+  bool flush();
+  void put(std::string_view s);
+
+private:
+  void put(char c);
+  void spaces(int n);
+  void string(std::string_view s);
+  void num(double d, bool json);
+  bool scalar(const DictG &g, bool json);
+
+  std::span<char> _buffer;
+  const Dict::Sink &_sink;
+  size_t _len = 0;
+  bool _ok = true;
+
+};
+
+} // vops
+
+bool Writer::flush() {
+
+  if (_len > 0 && _ok) {
+    _ok = _sink(std::string_view(_buffer.data(), _len));
+  }
+  _len = 0;
+  return _ok;
+
+}
+
+void Writer::put(char c) {
+
+  if (_len == _buffer.size()) {
+    flush();
+  }
+  _buffer[_len++] = c;
+
+}
+
+void Writer::put(std::string_view s) {
+
+  while (!s.empty()) {
+    if (_len == _buffer.size()) {
+      flush();
+    }
+    auto n = std::min(s.size(), _buffer.size() - _len);
+    memcpy(_buffer.data() + _len, s.data(), n);
+    _len += n;
+    s.remove_prefix(n);
+  }
+
+}
+
+void Writer::spaces(int n) {
+
+  for (int i=0; i<n; i++) {
+    put(' ');
+  }
+
+}
+
+void Writer::string(std::string_view s) {
+
+  // copy everything up to the next thing that needs escaping.
+  put('"');
+  char buf[6];
+  size_t i = 0;
+  while (true) {
+    auto n = json::findEscape(s, i);
+    put(s.substr(i, n - i));
+    if (n >= s.size()) {
+      break;
+    }
+    put(json::escaped(s[n], buf));
+    i = n + 1;
+  }
+  put('"');
+
+}
+
+void Writer::num(double d, bool json) {
+
+  if (std::isnan(d)) {
+    put(json ? "null" : ".nan");
+    return;
+  }
+  if (std::isinf(d)) {
+    put(json ? "null" : (d < 0 ? "-.inf" : ".inf"));
+    return;
+  }
+
+  // the shortest digits that read back the same, laid out the way reflect-cpp
+  // (yyjson) did it so nothing changes for anyone: 100000.0, 0.000001, 1e-7, 
+  // 1.5e300. It always looks like a double.
+  char buf[32];
+  auto r = std::to_chars(buf, buf + sizeof(buf), d, std::chars_format::scientific);
+  std::string_view s(buf, r.ptr - buf);
+  if (s.front() == '-') {
+    put('-');
+    s.remove_prefix(1);
+  }
+  auto e = s.find('e');
+  int exp = 0;
+  std::from_chars(s.data() + e + (s[e + 1] == '+' ? 2 : 1), s.data() + s.size(), exp);
+  char dbuf[24];
+  dbuf[0] = s[0];
+  if (e > 1) {
+    memcpy(dbuf + 1, s.data() + 2, e - 2);
+  }
+  std::string_view digits(dbuf, e > 1 ? e - 1 : 1);
+  if (digits == "0") {
+    put("0.0");
+    return;
+  }
+  
+  // where the point goes from the front of the digits.
+  int n = digits.size();
+  int dot = exp + 1;
+  if (dot > -6 && dot <= 21) {
+    if (dot <= 0) {
+      put("0.");
+      for (int i=0; i<-dot; i++) {
+        put('0');
+      }
+      put(digits);
+    }
+    else if (dot >= n) {
+      put(digits);
+      for (int i=0; i<dot - n; i++) {
+        put('0');
+      }
+      put(".0");
+    }
+    else {
+      put(digits.substr(0, dot));
+      put('.');
+      put(digits.substr(dot));
+    }
+    return;
+  }
+  put(digits[0]);
+  if (n > 1) {
+    put('.');
+    put(digits.substr(1));
+  }
+  put('e');
+  char ebuf[8];
+  auto er = std::to_chars(ebuf, ebuf + sizeof(ebuf), exp);
+  put(std::string_view(ebuf, er.ptr - ebuf));
+
+}
+
+bool Writer::scalar(const DictG &g, bool json) {
+
+  return std::visit([this, json](const auto &v) {
+    using T = std::decay_t<decltype(v)>;
+    if constexpr (std::is_same_v<T, bool>) {
+      put(v ? "true" : "false");
+    }
+    else if constexpr (std::is_same_v<T, int64_t>) {
+      char buf[24];
+      auto r = std::to_chars(buf, buf + sizeof(buf), v);
+      put(std::string_view(buf, r.ptr - buf));
+    }
+    else if constexpr (std::is_same_v<T, double>) {
+      num(v, json);
+    }
+    else if constexpr (std::is_same_v<T, std::string>) {
+      string(v);
+    }
+    else if constexpr (std::is_same_v<T, DictO>) {
+      if (!v.empty()) {
+        return false;
+      }
+      put("{}");
+    }
+    else if constexpr (std::is_same_v<T, DictV>) {
+      if (!v.empty()) {
+        return false;
+      }
+      put("[]");
+    }
+    else {
+      put("null");
+    }
+    return true;
+  }, g.variant());
+
+}
+
+bool Writer::json(const DictG &g, bool pretty, int indent) {
+
+  if (scalar(g, true)) {
+    return _ok;
+  }
+
+  // the same layout as toString.
+  auto obj = Dict::getObjectPtr(g);
+  if (obj) {
+    put('{');
+    bool first = true;
+    for (auto &e: *obj) {
+      if (!_ok) {
+        return false;
+      }
+      if (!first) {
+        put(',');
+      }
+      first = false;
+      if (pretty) {
+        put('\n');
+        spaces((indent + 1) * 4);
+      }
+      string(e.first);
+      put(pretty ? ": " : ":");
+      json(e.second, pretty, indent + 1);
+    }
+    if (pretty) {
+      put('\n');
+      spaces(indent * 4);
+    }
+    put('}');
+    return _ok;
+  }
+
+  auto v = Dict::getVectorPtr(g);
+  put('[');
+  bool first = true;
+  for (auto &e: *v) {
+    if (!_ok) {
+      return false;
+    }
+    if (!first) {
+      put(',');
+    }
+    first = false;
+    if (pretty) {
+      put('\n');
+      spaces((indent + 1) * 4);
+    }
+    json(e, pretty, indent + 1);
+  }
+  if (pretty) {
+    put('\n');
+    spaces(indent * 4);
+  }
+  put(']');
+  return _ok;
+
+}
+
+static bool block(const DictG &g) {
+
+  auto obj = Dict::getObjectPtr(g);
+  if (obj) {
+    return !obj->empty();
+  }
+  auto v = Dict::getVectorPtr(g);
+  return v && !v->empty();
+  
+}
+
+bool Writer::yaml(const DictG &g, int indent, bool inlined) {
+
+  // block style, everything that isn't empty is on it's own line. "inlined" is
+  // when we are just after a "- " so the first line is already indented.
+  if (scalar(g, false)) {
+    put('\n');
+    return _ok;
+  }
+
+  auto obj = Dict::getObjectPtr(g);
+  if (obj) {
+    bool first = true;
+    for (auto &e: *obj) {
+      if (!_ok) {
+        return false;
+      }
+      if (!first || !inlined) {
+        spaces(indent);
+      }
+      first = false;
+      string(e.first);
+      put(block(e.second) ? ":\n" : ": ");
+      yaml(e.second, indent + 2, false);
+    }
+    return _ok;
+  }
+
+  auto v = Dict::getVectorPtr(g);
+  bool first = true;
+  for (auto &e: *v) {
+    if (!_ok) {
+      return false;
+    }
+    if (!first || !inlined) {
+      spaces(indent);
+    }
+    first = false;
+    put("- ");
+    yaml(e, indent + 2, true);
+  }
+  return _ok;
+
+}
+
+bool codec::writeJSON(const DictG &g, bool pretty, std::span<char> buffer, const Dict::Sink &sink) {
+
+  Writer w(buffer, sink);
+  w.json(g, pretty, 0);
+  return w.flush();
+
+}
+
+bool codec::writeYAML(const DictG &g, bool, std::span<char> buffer, const Dict::Sink &sink) {
+
+  Writer w(buffer, sink);
+  w.yaml(g, 0, false);
+  return w.flush();
+
+}
+
+bool Dict::write(const DictG &g, std::span<char> buffer, const Sink &sink, bool pretty, const std::string &format) {
+
+  if (buffer.empty()) {
+    BOOST_LOG_TRIVIAL(error) << "no buffer to write into";
+    return false;
+  }
+
+  auto codec = DictCodec::get(format);
+  if (!codec) {
+    BOOST_LOG_TRIVIAL(error) << "invalid format " << format;
+    return false;
+  }
+  if (codec->stream) {
+    return codec->stream(g, pretty, buffer, sink);
+  }
+  
+  // it can only make it in one go, so just hand that over a chunk at a time.
+  auto s = codec->write(g, pretty);
+  if (!s) {
+    return false;
+  }
+  Writer w(buffer, sink);
+  w.put(*s);
+  return w.flush();
+
+}
+
+bool Dict::write(const DictG &g, const Sink &sink, bool pretty, const std::string &format, size_t chunk) {
+
+  std::vector<char> buffer(chunk);
+  return write(g, buffer, sink, pretty, format);
+
+}
+
+bool Dict::write(const DictG &g, std::ostream &s, bool pretty, const std::string &format, size_t chunk) {
+
+  return write(g, [&s](std::string_view c) {
+    s.write(c.data(), c.size());
+    return s.good();
+  }, pretty, format, chunk);
+
+}
@@ -0,0 +1,270 @@
+/*
+  codectest.cpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+
+  https://github.com/visualopsholdings/dict
+*/
+
+#include "dict.hpp"
+#include "dictcodec.hpp"
+
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <filesystem>
+
+#define BOOST_AUTO_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace vops;
+namespace fs = std::filesystem;
+
+const string codecJSON = R"({
+  "name": "a \"string\" with\u0000nulls",
+  "int": 42,
+  "big": 9007199254740993,
+  "neg": -7,
+  "double": 1.5,
+  "bool": true,
+  "null": null,
+  "obj": { "a": [1, "two", 3.25, false, {}], "b": [] },
+  "utf8": "héllo wörld"
+})";
+
+BOOST_AUTO_TEST_CASE( binaryRoundTrip )
+{
+  cout << "=== binaryRoundTrip ===" << endl;
+
+  auto g = Dict::parseString(codecJSON);
+  BOOST_CHECK(g);
+
+  for (auto format: { ".bson", ".msgpack", ".cbor" }) {
+    if (!Dict::hasFormat(format)) {
+      cout << format << " not built" << endl;
+      continue;
+    }
+    auto s = Dict::toString(*g, false, format);
+    cout << format << " " << s.size() << " bytes" << endl;
+    BOOST_CHECK(s != "???");
+
+    auto g2 = Dict::parseString(s, format);
+    BOOST_CHECK(g2);
+    BOOST_CHECK(Dict::equals(*g, *g2));
+
+    stringstream ss(s);
+    auto g3 = Dict::parseStream(ss, format);
+    BOOST_CHECK(g3);
+    BOOST_CHECK(Dict::equals(*g, *g3));
+
+    // written a chunk at a time is just the same bytes.
+    string out;
+    BOOST_CHECK(Dict::write(*g, [&out](string_view c) {
+      out += c;
+      return true;
+    }, false, format, 7));
+    BOOST_CHECK(out == s);
+
+    // and garbage doesn't parse.
+    BOOST_CHECK(!Dict::parseString(s.substr(0, s.size() / 2), format));
+  }
+
+}
+
+BOOST_AUTO_TEST_CASE( binaryFile )
+{
+  cout << "=== binaryFile ===" << endl;
+
+  auto g = Dict::parseString(codecJSON);
+  BOOST_CHECK(g);
+
+  auto dir = fs::temp_directory_path() / "codectest";
+  fs::create_directories(dir);
+
+  for (auto format: { ".bson", ".msgpack", ".cbor" }) {
+    if (!Dict::hasFormat(format)) {
+      continue;
+    }
+    auto fn = (dir / (string("test") + format)).string();
+    {
+      ofstream f(fn, ios::binary);
+      BOOST_CHECK(Dict::write(*g, f, false, format));
+    }
+    auto g2 = Dict::parseFile(fn);
+    BOOST_CHECK(g2);
+    BOOST_CHECK(Dict::equals(*g, *g2));
+  }
+
+  fs::remove_all(dir);
+
+}
+
+BOOST_AUTO_TEST_CASE( notBuilt )
+{
+  cout << "=== notBuilt ===" << endl;
+
+  // whatever we were built with, these always fail the same way.
+  DictG g = dictO({ { "a", 1 } });
+  for (auto format: { ".bson", ".msgpack", ".cbor", ".xml" }) {
+    if (Dict::hasFormat(format)) {
+      continue;
+    }
+    BOOST_CHECK_EQUAL(Dict::toString(g, false, format), "???");
+    BOOST_CHECK(!Dict::parseString("{}", format));
+    stringstream ss;
+    BOOST_CHECK(!Dict::write(g, ss, false, format));
+  }
+  BOOST_CHECK(Dict::hasFormat(".json"));
+  BOOST_CHECK(Dict::hasFormat(".yml"));
+
+}
+
+BOOST_AUTO_TEST_CASE( addCodec )
+{
+  cout << "=== addCodec ===" << endl;
+
+  // lines of "key=value" that start with a magic line.
+  auto id = DictCodec::add({
+    .format = ".kv",
+    .parse = [](string_view s) -> optional<DictG> {
+      if (!s.starts_with("#kv\n")) {
+        return nullopt;
+      }
+      DictO o;
+      stringstream ss{string(s.substr(4))};
+      string line;
+      while (getline(ss, line)) {
+        auto eq = line.find('=');
+        if (eq == string::npos) {
+          return nullopt;
+        }
+        o[line.substr(0, eq)] = line.substr(eq + 1);
+      }
+      return o;
+    },
+    .write = [](const DictG &g, bool) -> optional<string> {
+      auto o = Dict::getObjectPtr(g);
+      if (!o) {
+        return nullopt;
+      }
+      string s = "#kv\n";
+      for (auto &e: *o) {
+        s += e.first + "=" + Dict::getString(e.second).value_or("") + "\n";
+      }
+      return s;
+    },
+    .stream = nullptr,
+    .sniff = [](string_view s) { return s.starts_with("#kv\n"); }
+  });
+  BOOST_CHECK(DictCodec::find(".kv") == id);
+  BOOST_CHECK_EQUAL(DictCodec::get(id)->format, ".kv");
+  BOOST_CHECK(Dict::hasFormat(".kv"));
+
+  DictG g = dictO({ { "a", "1" }, { "b", "two" } });
+  auto s = Dict::toString(g, false, ".kv");
+  BOOST_CHECK_EQUAL(s, "#kv\na=1\nb=two\n");
+  auto g2 = Dict::parseString(s, ".kv");
+  BOOST_CHECK(g2);
+  BOOST_CHECK(Dict::equals(g, *g2));
+
+  // it doesn't stream, so it's handed over in chunks.
+  string out;
+  BOOST_CHECK(Dict::write(g, [&out](string_view c) {
+    BOOST_CHECK(c.size() <= 4);
+    out += c;
+    return true;
+  }, false, ".kv", 4));
+  BOOST_CHECK_EQUAL(out, s);
+
+  // and it's found when we don't say.
+  g2 = Dict::parseString(s, "");
+  BOOST_CHECK(g2);
+  BOOST_CHECK(Dict::equals(g, *g2));
+
+  // adding it again replaces it.
+  auto codec = *DictCodec::get(id);
+  codec.write = [](const DictG &, bool) -> optional<string> { return "#kv\nreplaced=yes\n"; };
+  BOOST_CHECK_EQUAL(DictCodec::add(codec), id);
+  BOOST_CHECK_EQUAL(Dict::toString(g, false, ".kv"), "#kv\nreplaced=yes\n");
+
+}
+
+BOOST_AUTO_TEST_CASE( replaceJSON )
+{
+  cout << "=== replaceJSON ===" << endl;
+
+  // wrap the JSON we have to count how many times it's used.
+  auto json = DictCodec::get(".json");
+  int parses = 0;
+  auto counted = *json;
+  counted.parse = [json, &parses](string_view s) {
+    parses++;
+    return json->parse(s);
+  };
+  auto id = DictCodec::add(counted);
+  BOOST_CHECK(DictCodec::find(".json") == id);
+
+  BOOST_CHECK(Dict::parseString("{ \"a\": 1 }"));
+  stringstream ss("[1, 2]");
+  BOOST_CHECK(Dict::parseStream(ss));
+  BOOST_CHECK_EQUAL(parses, 2);
+
+  // and put it back.
+  DictCodec::add(*json);
+  BOOST_CHECK(Dict::parseString("{ \"a\": 1 }"));
+  BOOST_CHECK_EQUAL(parses, 2);
+
+}
+
+BOOST_AUTO_TEST_CASE( sniff )
+{
+  cout << "=== sniff ===" << endl;
+
+  auto g = Dict::parseString(codecJSON);
+  BOOST_CHECK(g);
+
+  // JSON comes before YML since it's fussier.
+  auto found = DictCodec::sniffAll("  \n{ \"a\": 1 }");
+  BOOST_CHECK(found.size() >= 2);
+  BOOST_CHECK_EQUAL(found[0]->format, ".json");
+  BOOST_CHECK(Dict::equals(*Dict::parseString(codecJSON, ""), *g));
+  BOOST_CHECK(!Dict::parseString("", ""));
+  BOOST_CHECK(!Dict::parseString(string("\x01\x02\x03", 3), ""));
+
+  // YAML that isn't JSON.
+  found = DictCodec::sniffAll("a: 1\nb:\n  - x\n");
+  BOOST_CHECK_EQUAL(found.size(), 1);
+  BOOST_CHECK_EQUAL(found[0]->format, ".yml");
+  found = DictCodec::sniffAll(string("\0[1]", 4));
+  BOOST_CHECK(find_if(found.begin(), found.end(), [](auto &c) { return c->format == ".json"; }) == found.end());
+
+  for (auto format: DictCodec::formats()) {
+    // YAML scalars don't say what type they are, so a string with a 0 in it
+    // or an integer too big for a double doesn't come back the same.
+    if (format == ".kv" || format == ".yml") {
+      continue;
+    }
+    auto s = Dict::toString(*g, false, format);
+    auto found = DictCodec::sniffAll(s);
+    BOOST_CHECK(find_if(found.begin(), found.end(), [&format](auto &c) { return c->format == format; }) != found.end());
+    auto g2 = Dict::parseString(s, "");
+    BOOST_CHECK(g2);
+    BOOST_CHECK(Dict::equals(*g, *g2));
+  }
+
+  // a file with an extension we don't know.
+  auto fn = (fs::temp_directory_path() / "codectest.conf").string();
+  {
+    ofstream f(fn);
+    f << codecJSON;
+  }
+  auto g2 = Dict::parseFile(fn);
+  BOOST_CHECK(g2);
+  BOOST_CHECK(Dict::equals(*g, *g2));
+  fs::remove(fn);
+
+}
@@ -254,3 +254,186 @@ BOOST_AUTO_TEST_CASE( getFirstKey )
 
 
 
+BOOST_AUTO_TEST_CASE( borrowed )
+{
+  cout << "=== borrowed ===" << endl;
+
+  DictG g = dictO({
+    { "a", dictO({
+      { "b", dictO({
+        { "c", "hello" },
+        { "n", 42 },
+        { "f", true }
+        })
+      },
+      { "v", DictV{ "x", "y" } }
+      })
+    }
+  });
+
+  auto a = Dict::getObjectPtr(Dict::getObjectPtr(g), "a");
+  BOOST_CHECK(a);
+  auto c = Dict::getStringView(Dict::getObjectPtr(a, "b"), "c");
+  BOOST_CHECK(c);
+  BOOST_CHECK_EQUAL(*c, "hello");
+  BOOST_CHECK_EQUAL(*Dict::getNum(Dict::getObjectPtr(a, "b"), "n"), 42);
+  BOOST_CHECK(*Dict::getBool(Dict::getObjectPtr(a, "b"), "f"));
+  
+  auto v = Dict::getVectorPtr(a, "v");
+  BOOST_CHECK(v);
+  BOOST_CHECK_EQUAL(v->size(), 2);
+  
+  // it really is pointing into the original.
+  BOOST_CHECK_EQUAL(Dict::getGenericPtr(a, "v"), &(a->begin() + 1)->second);
+  
+}
+
+BOOST_AUTO_TEST_CASE( borrowedMissing )
+{
+  cout << "=== borrowedMissing ===" << endl;
+
+  DictG g = dictO({ { "a", "hello" } });
+
+  BOOST_CHECK(!Dict::getObjectPtr(Dict::getObjectPtr(g), "a"));
+  BOOST_CHECK(!Dict::getStringView(Dict::getObjectPtr(Dict::getObjectPtr(g), "a"), "b"));
+  BOOST_CHECK(!Dict::getStringView(Dict::getObjectPtr(g), "b"));
+  BOOST_CHECK(!Dict::getVectorPtr(g));
+  
+}
+
+
+BOOST_AUTO_TEST_CASE( indexed )
+{
+  cout << "=== indexed ===" << endl;
+
+  DictO obj;
+  for (int i=0; i<100; i++) {
+    obj["k" + to_string(i)] = i;
+  }
+  
+  Dict::Index index(obj, 10);
+  BOOST_CHECK(index.get("k50"));
+  BOOST_CHECK_EQUAL(get<long>(index.get("k50")->variant()), 50);
+  BOOST_CHECK(!index.get("nothing"));
+  
+  BOOST_CHECK(index.set("k50", 500));
+  BOOST_CHECK(index.set("new", 1));
+  BOOST_CHECK_EQUAL(get<long>(index.get("k50")->variant()), 500);
+  BOOST_CHECK(index.get("new"));
+  
+  BOOST_CHECK(index.remove("k0"));
+  BOOST_CHECK(!index.remove("k0"));
+  BOOST_CHECK(!index.get("k0"));
+  BOOST_CHECK_EQUAL(get<long>(index.get("k99")->variant()), 99);
+  
+  // still in the order they went in.
+  BOOST_CHECK_EQUAL(obj.size(), 100);
+  BOOST_CHECK_EQUAL(*Dict::getFirstKey(obj), "k1");
+  BOOST_CHECK_EQUAL((obj.begin() + 49)->first, "k50");
+  BOOST_CHECK_EQUAL((obj.begin() + 99)->first, "new");
+  
+}
+
+BOOST_AUTO_TEST_CASE( indexedChanged )
+{
+  cout << "=== indexedChanged ===" << endl;
+
+  DictO obj;
+  for (int i=0; i<100; i++) {
+    obj["k" + to_string(i)] = i;
+  }
+  
+  Dict::Index index(obj, 10);
+  BOOST_CHECK(index.get("k1"));
+  
+  // changed without the index knowing.
+  for (int i=100; i<1000; i++) {
+    obj["k" + to_string(i)] = i;
+  }
+  BOOST_CHECK_EQUAL(get<long>(index.get("k999")->variant()), 999);
+  
+  DictO other;
+  other["k1"] = "other";
+  for (int i=0; i<20; i++) {
+    other["x" + to_string(i)] = i;
+  }
+  obj = other;
+  BOOST_CHECK(!index.get("k999"));
+  BOOST_CHECK_EQUAL(*Dict::getStringView(*index.get("k1")), "other");
+  
+}
+
+BOOST_AUTO_TEST_CASE( indexedSameSize )
+{
+  cout << "=== indexedSameSize ===" << endl;
+
+  DictO obj;
+  for (int i=0; i<100; i++) {
+    obj["k" + to_string(i)] = i;
+  }
+  
+  Dict::Index index(obj, 10);
+  BOOST_CHECK(index.get("k1"));
+  
+  // the same size, with the keys moved around.
+  DictO other;
+  for (int i=0; i<100; i++) {
+    other["k" + to_string(99 - i)] = 99 - i;
+  }
+  obj = other;
+  BOOST_CHECK_EQUAL(get<long>(index.get("k1")->variant()), 1);
+  
+  // and totally different keys, which it has to be told about.
+  DictO other2;
+  for (int i=0; i<100; i++) {
+    other2["x" + to_string(i)] = i;
+  }
+  obj = other2;
+  index.changed();
+  BOOST_CHECK_EQUAL(get<long>(index.get("x50")->variant()), 50);
+  BOOST_CHECK(!index.get("k1"));
+  BOOST_CHECK_EQUAL(get<long>(index.get("x60")->variant()), 60);
+  
+}
+
+BOOST_AUTO_TEST_CASE( indexedUntold )
+{
+  cout << "=== indexedUntold ===" << endl;
+
+  DictO obj;
+  for (int i=0; i<100; i++) {
+    obj["k" + to_string(i)] = i;
+  }
+  DictG g = obj;
+  
+  Dict::Index index(get<DictO>(g.variant()), 10);
+  BOOST_CHECK(index.get("k50"));
+  
+  // none of these change the index.
+  BOOST_CHECK(Dict::set_at_pointer_in_place(g, "/k50", DictG(500)));
+  BOOST_CHECK(Dict::set_at_pointer_in_place(g, "/new", DictG(1)));
+  auto patch = Dict::parseString(R"([
+    { "op": "remove", "path": "/k0" },
+    { "op": "move", "from": "/k1", "path": "/moved" },
+    { "op": "add", "path": "/k2", "value": 20 }
+  ])");
+  BOOST_REQUIRE(patch);
+  BOOST_CHECK(Dict::applyPatch(g, *Dict::getVectorPtr(*patch)));
+  Dict::mergePatch(g, dictO({ { "k3", DictG() }, { "k4", 40 }, { "merged", true } }));
+  
+  // so it has to be told.
+  index.changed();
+  BOOST_CHECK_EQUAL(get<long>(index.get("k50")->variant()), 500);
+  BOOST_CHECK_EQUAL(get<long>(index.get("new")->variant()), 1);
+  BOOST_CHECK_EQUAL(get<long>(index.get("moved")->variant()), 1);
+  BOOST_CHECK_EQUAL(get<long>(index.get("k2")->variant()), 20);
+  BOOST_CHECK_EQUAL(get<long>(index.get("k4")->variant()), 40);
+  BOOST_CHECK(index.get("merged"));
+  BOOST_CHECK(!index.get("k0"));
+  BOOST_CHECK(!index.get("k1"));
+  BOOST_CHECK(!index.get("k3"));
+  for (auto &e: *Dict::getObjectPtr(g)) {
+    BOOST_CHECK(index.get(e.first) == &e.second);
+  }
+
+}
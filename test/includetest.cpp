@@ -11,14 +11,17 @@
 
 
 #include "dict.hpp"
+#include "dictincludes.hpp"
 
 #include <boost/log/trivial.hpp>
+#include <fstream>
 
 #define BOOST_AUTO_TEST_MAIN
 #include <boost/test/unit_test.hpp>
 
 using namespace std;
 using namespace vops;
+using namespace std::chrono_literals;
 
 BOOST_AUTO_TEST_CASE( simple )
 {
@@ -59,4 +62,195 @@ BOOST_AUTO_TEST_CASE( simple )
   BOOST_CHECK(ddd);
   BOOST_CHECK_EQUAL(*ddd, 2);
  
+  auto p = Dict::parseFile(path / "include.json", false, 0);
+  BOOST_CHECK(p);
+  BOOST_CHECK_EQUAL(Dict::toString(*d), Dict::toString(*p));
+
+}
+
+BOOST_AUTO_TEST_CASE( mapped )
+{
+  cout << "=== mapped ===" << endl;
+ 
+  std::filesystem::path path = "../dict-src/test";
+  if (!std::filesystem::exists(path)) {
+    path = "../test";
+  }
+
+  auto d = Dict::parseFile(path / "include.json");
+  BOOST_CHECK(d);
+  
+  // map even the smallest file.
+  Dict::setMmapThreshold(0);
+  auto m = Dict::parseFile(path / "include.json");
+  Dict::setMmapThreshold(1024 * 1024);
+  BOOST_CHECK(m);
+  BOOST_CHECK(Dict::equals(*d, *m));
+  
+  BOOST_CHECK(!Dict::parseFile(path / "missing.json"));
+ 
+}
+
+BOOST_AUTO_TEST_CASE( shared )
+{
+  cout << "=== shared ===" << endl;
+ 
+  auto dir = std::filesystem::temp_directory_path() / "includetest-shared";
+  std::filesystem::create_directories(dir / "sub");
+  {
+    ofstream f(dir / "common.json");
+    f << "{ \"name\": \"common\", \"value\": 1 }";
+  }
+  {
+    ofstream f(dir / "sub" / "part.json");
+    f << "{ \"...\": \"<../common.json>\", \"value\": 2 }";
+  }
+  {
+    ofstream f(dir / "root.json");
+    f << "[ { \"...\": \"<common.json>\" }, { \"...\": \"<sub/part.json>\" }, { \"...\": \"<sub/../common.json>\", \"value\": 3 }, { \"...\": \"<sub/part.json>\" } ]";
+  }
+  
+  auto d = Dict::parseFile(dir / "root.json");
+  BOOST_CHECK(d);
+  cout << Dict::toString(*d) << endl;
+  auto v = Dict::getVector(*d);
+  BOOST_CHECK(v);
+  BOOST_CHECK_EQUAL(v->size(), 4);
+  for (auto &e: *v) {
+    BOOST_CHECK_EQUAL(*Dict::getStringG(e, "name"), "common");
+  }
+  BOOST_CHECK_EQUAL(*Dict::getNumG((*v)[0], "value"), 1);
+  BOOST_CHECK_EQUAL(*Dict::getNumG((*v)[1], "value"), 2);
+  BOOST_CHECK_EQUAL(*Dict::getNumG((*v)[2], "value"), 3);
+  BOOST_CHECK_EQUAL(*Dict::getNumG((*v)[3], "value"), 2);
+  
+  // and loading them in parallel is exactly the same.
+  auto p = Dict::parseFile(dir / "root.json", false, 4);
+  BOOST_CHECK(p);
+  BOOST_CHECK_EQUAL(Dict::toString(*d), Dict::toString(*p));
+  
+  std::filesystem::remove_all(dir);
+  
+}
+
+BOOST_AUTO_TEST_CASE( cycle )
+{
+  cout << "=== cycle ===" << endl;
+ 
+  auto dir = std::filesystem::temp_directory_path() / "includetest-cycle";
+  std::filesystem::create_directories(dir);
+  {
+    ofstream f(dir / "a.json");
+    f << "{ \"...\": \"<b.json>\", \"a\": 1 }";
+  }
+  {
+    ofstream f(dir / "b.json");
+    f << "{ \"...\": \"<a.json>\", \"b\": 2 }";
+  }
+  
+  // the include back to a is just left out.
+  auto d = Dict::parseFile(dir / "a.json");
+  BOOST_CHECK(d);
+  BOOST_CHECK_EQUAL(*Dict::getNumG(*d, "a"), 1);
+  BOOST_CHECK_EQUAL(*Dict::getNumG(*d, "b"), 2);
+  
+  auto p = Dict::parseFile(dir / "a.json", false, 2);
+  BOOST_CHECK(p);
+  BOOST_CHECK_EQUAL(Dict::toString(*d), Dict::toString(*p));
+
+  std::filesystem::remove_all(dir);
+  
+}
+
+BOOST_AUTO_TEST_CASE( reload )
+{
+  cout << "=== reload ===" << endl;
+ 
+  auto dir = std::filesystem::temp_directory_path() / "includetest-reload";
+  std::filesystem::create_directories(dir);
+  auto write = [&dir](const string &fn, const string &json) {
+    ofstream f(dir / fn);
+    f << json;
+  };
+  write("root.json", "{ \"db\": { \"...\": \"<db.json>\" }, \"web\": { \"...\": \"<web.json>\" } }");
+  write("db.json", "{ \"host\": \"localhost\", \"port\": 5432 }");
+  write("web.json", "{ \"port\": 80 }");
+  
+  DictIncludes includes;
+  auto d = Dict::parseFile((dir / "root.json").string(), includes);
+  BOOST_CHECK(d);
+  BOOST_CHECK_EQUAL(includes.files().size(), 3);
+  auto root = includes.files().at(includes.root());
+  BOOST_CHECK_EQUAL(root.includes.size(), 2);
+  BOOST_CHECK_EQUAL(*Dict::getNum(*Dict::find_pointer(*d, "/db/port")), 5432);
+
+  // nothing changed.
+  bool changed;
+  auto r = includes.reload(&changed);
+  BOOST_CHECK(r);
+  BOOST_CHECK(!changed);
+  
+  // change one file, and make sure it looks newer.
+  auto web = includes.files().at((std::filesystem::weakly_canonical(dir / "web.json")).string());
+  write("db.json", "{ \"host\": \"db.example.com\", \"port\": 5432 }");
+  std::filesystem::last_write_time(dir / "db.json", std::filesystem::file_time_type::clock::now() + 1s);
+  r = includes.reload(&changed);
+  BOOST_CHECK(r);
+  BOOST_CHECK(changed);
+  BOOST_CHECK_EQUAL(*Dict::getString(*Dict::find_pointer(*r, "/db/host")), "db.example.com");
+  BOOST_CHECK_EQUAL(*Dict::getNum(*Dict::find_pointer(*r, "/web/port")), 80);
+  BOOST_CHECK(Dict::equals(*r, *Dict::parseFile((dir / "root.json").string())));
+  
+  // web wasn't touched.
+  BOOST_CHECK(includes.files().at((std::filesystem::weakly_canonical(dir / "web.json")).string()).mtime == web.mtime);
+  
+  // a file that doesn't parse leaves everything alone.
+  write("web.json", "{ \"port\": ");
+  std::filesystem::last_write_time(dir / "web.json", std::filesystem::file_time_type::clock::now() + 2s);
+  BOOST_CHECK(!includes.reload());
+  write("web.json", "{ \"port\": 8080 }");
+  std::filesystem::last_write_time(dir / "web.json", std::filesystem::file_time_type::clock::now() + 3s);
+  r = includes.reload();
+  BOOST_CHECK(r);
+  BOOST_CHECK_EQUAL(*Dict::getNum(*Dict::find_pointer(*r, "/web/port")), 8080);
+  
+  // stop including a file and it's forgotten.
+  write("root.json", "{ \"db\": { \"...\": \"<db.json>\" } }");
+  std::filesystem::last_write_time(dir / "root.json", std::filesystem::file_time_type::clock::now() + 4s);
+  r = includes.reload();
+  BOOST_CHECK(r);
+  BOOST_CHECK(!Dict::find_pointer(*r, "/web"));
+  BOOST_CHECK_EQUAL(includes.files().size(), 2);
+  
+  // includes inside the keys that override an include.
+  write("root.json", "{ \"db\": { \"...\": \"<db.json>\", \"pool\": [ { \"...\": \"<web.json>\", \"size\": 1 } ] } }");
+  std::filesystem::last_write_time(dir / "root.json", std::filesystem::file_time_type::clock::now() + 5s);
+  r = includes.reload();
+  BOOST_CHECK(r);
+  BOOST_CHECK_EQUAL(*Dict::getNum(*Dict::find_pointer(*r, "/db/pool/0/port")), 8080);
+  write("web.json", "{ \"port\": 8081, \"size\": 2 }");
+  std::filesystem::last_write_time(dir / "web.json", std::filesystem::file_time_type::clock::now() + 6s);
+  r = includes.reload();
+  BOOST_CHECK(r);
+  BOOST_CHECK_EQUAL(*Dict::getNum(*Dict::find_pointer(*r, "/db/pool/0/port")), 8081);
+  BOOST_CHECK_EQUAL(*Dict::getNum(*Dict::find_pointer(*r, "/db/pool/0/size")), 1);
+  BOOST_CHECK(Dict::equals(*r, *Dict::parseFile((dir / "root.json").string())));
+  
+  // an include that is thrown away by a later include in the same object.
+  write("root.json", "{ \"x\": { \"...\": \"<db.json>\" }, \"...\": \"<web.json>\" }");
+  write("web.json", "{ \"x\": \"fromWeb\" }");
+  std::filesystem::last_write_time(dir / "root.json", std::filesystem::file_time_type::clock::now() + 7s);
+  std::filesystem::last_write_time(dir / "web.json", std::filesystem::file_time_type::clock::now() + 7s);
+  r = includes.reload();
+  BOOST_CHECK(r);
+  BOOST_CHECK_EQUAL(*Dict::getString(*Dict::find_pointer(*r, "/x")), "fromWeb");
+  write("db.json", "{ \"fromDB\": 2 }");
+  std::filesystem::last_write_time(dir / "db.json", std::filesystem::file_time_type::clock::now() + 8s);
+  r = includes.reload();
+  BOOST_CHECK(r);
+  BOOST_CHECK_EQUAL(*Dict::getString(*Dict::find_pointer(*r, "/x")), "fromWeb");
+  BOOST_CHECK(Dict::equals(*r, *Dict::parseFile((dir / "root.json").string())));
+  
+  std::filesystem::remove_all(dir);
+  
 }
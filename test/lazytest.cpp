@@ -0,0 +1,107 @@
+/*
+  lazytest.cpp
+  
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+  
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+ 
+  https://github.com/visualopsholdings/dict
+*/
+
+
+#include "dictlazy.hpp"
+
+#include <iostream>
+
+#define BOOST_AUTO_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace vops;
+
+const string complexJSON = R"({
+  "accesses": [
+    { "name": "view", "groups": [], "users": [ "667d0baedfb1ed18430d8ed3" ] },
+    { "name": "edit", "groups": [ "667d0bae39ae84d0890a2141" ], "users": [] },
+    { "name": "exec", "groups": [], "users": [ "667d0baedfb1ed18430d8ed3", "667d0baedfb1ed18430d8ed4" ] }
+  ],
+  "other": { "a": 1, "b": true, "c": null, "d": -2.5e3, "e\"scaped": "tab\there é" }
+})";
+
+BOOST_AUTO_TEST_CASE( lazyWhole )
+{
+  cout << "=== lazyWhole ===" << endl;
+  
+  auto lazy = Dict::parseLazy(complexJSON);
+  BOOST_CHECK(lazy);
+  auto g = lazy->toG();
+  BOOST_CHECK(g);
+  BOOST_CHECK(Dict::equals(*g, *Dict::parseString(complexJSON)));
+  
+}
+
+BOOST_AUTO_TEST_CASE( lazyGetters )
+{
+  cout << "=== lazyGetters ===" << endl;
+  
+  auto lazy = Dict::parseLazy(complexJSON);
+  BOOST_CHECK(lazy);
+  
+  auto other = lazy->root().object("other");
+  BOOST_CHECK_EQUAL(*other.getFirstKey(), "a");
+  BOOST_CHECK_EQUAL(*other.object("a").getNum(), 1);
+  BOOST_CHECK(*other.object("b").getBool());
+  BOOST_CHECK_EQUAL(*other.object("e\"scaped").getString(), "tab\there é");
+  BOOST_CHECK(!other.object("a").getString());
+  BOOST_CHECK(!other.object("d").getNum());
+  
+  auto users = lazy->find_pointer("/accesses/2/users/1");
+  BOOST_CHECK(users);
+  BOOST_CHECK_EQUAL(*users->getString(), "667d0baedfb1ed18430d8ed4");
+  BOOST_CHECK(!lazy->find_pointer("/accesses/3"));
+  BOOST_CHECK(!lazy->find_pointer("/other/x"));
+  
+  auto access = lazy->find_pointer("/accesses/1");
+  BOOST_CHECK(access);
+  BOOST_CHECK_EQUAL(Dict(access->toG()).object("groups").vector(0).string(), "667d0bae39ae84d0890a2141");
+  
+}
+
+BOOST_AUTO_TEST_CASE( lazyMonad )
+{
+  cout << "=== lazyMonad ===" << endl;
+  
+  auto lazy = Dict::parseLazy(complexJSON);
+  BOOST_CHECK(lazy);
+  auto root = lazy->root();
+  
+  BOOST_CHECK_EQUAL(root.object("accesses").vector(1).object("name").string(), "edit");
+  BOOST_CHECK_EQUAL(root.object("accesses").size(), 3);
+  BOOST_CHECK_EQUAL(root.object("accesses").vector(1).object("users").size(), 0);
+  BOOST_CHECK_EQUAL(root.object("other").object("a").num(), 1);
+  BOOST_CHECK(root.object("other").object("b").boolean());
+  
+  BOOST_CHECK_EQUAL(root.object("accesses").object("aaaaa").string(), "Path: /accesses Err: Dict is not an object");
+  BOOST_CHECK_EQUAL(root.object("accesses").vector(3).object("bbbbb").string(), "Path: /accesses Err: index 3 is invalid");
+  BOOST_CHECK_EQUAL(root.object("accesses").vector(2).object("bbbbb").string(), "Path: /accesses/2 Err: bbbbb not found");
+  
+}
+
+BOOST_AUTO_TEST_CASE( lazyBad )
+{
+  cout << "=== lazyBad ===" << endl;
+  
+  BOOST_CHECK(!Dict::parseLazy(""));
+  BOOST_CHECK(!Dict::parseLazy("{"));
+  BOOST_CHECK(!Dict::parseLazy("[1, 2}"));
+  BOOST_CHECK(!Dict::parseLazy("[1] x"));
+  BOOST_CHECK(!Dict::parseLazy("\"abc"));
+  
+  // only found when you look at it.
+  auto lazy = Dict::parseLazy("{ \"a\": [1, 2,], \"b\": 1 }");
+  BOOST_CHECK(lazy);
+  BOOST_CHECK_EQUAL(lazy->root().object("b").num(), 1);
+  BOOST_CHECK(!lazy->find_pointer("/a")->toG());
+  
+}
@@ -147,3 +147,64 @@ BOOST_AUTO_TEST_CASE( num )
 }
 
 
+BOOST_AUTO_TEST_CASE( refSimple )
+{
+  cout << "=== refSimple ===" << endl;
+  
+  setupLog();
+
+  DictG g = complexObj;
+  
+  BOOST_CHECK_EQUAL(ResultRef(g).object("accesses").vector(1).object("name").string(), "edit");
+  BOOST_CHECK_EQUAL(ResultRef(g).object("accesses").vector(2).object("users").size(), 2);
+  BOOST_CHECK_EQUAL(ResultRef(simpleNumObj).object("aaaa").num(), 42);
+  BOOST_CHECK(ResultRef(simpleBoolObj).object("aaaa").boolean());
+  
+  // we are just walking the original.
+  auto users = ResultRef(g).object("accesses").vector(2).object("users");
+  BOOST_CHECK_EQUAL(users.get(), Dict::getGenericPtr(Dict::getObjectPtr((*Dict::getVectorPtr(Dict::getObjectPtr(g), "accesses"))[2]), "users"));
+  
+}
+
+BOOST_AUTO_TEST_CASE( refErrors )
+{
+  cout << "=== refErrors ===" << endl;
+  
+  setupLog();
+
+  DictG g = complexObj;
+  
+  BOOST_CHECK_EQUAL(ResultRef(simpleStringObj).object("cccc").string(), "Err: cccc not found");
+  BOOST_CHECK_EQUAL(ResultRef(simpleNumObj).object("aaaa").string(), "Err: not a string");
+  BOOST_CHECK_EQUAL(ResultRef(g).object("accesses").object("aaaaa").string(), "Path: /accesses Err: Dict is not an object");
+  BOOST_CHECK_EQUAL(ResultRef(g).object("accesses").vector(3).object("bbbbb").string(), "Path: /accesses Err: index 3 is invalid");
+  BOOST_CHECK_EQUAL(ResultRef(g).object("accesses").vector(2).object("bbbbb").string(), "Path: /accesses/2 Err: bbbbb not found");
+  BOOST_CHECK_EQUAL(ResultRef(std::optional<DictG>()).string(), "nullopt");
+  
+}
+
+BOOST_AUTO_TEST_CASE( dictRef )
+{
+  cout << "=== dictRef ===" << endl;
+  
+  setupLog();
+
+  DictG g = complexObj;
+  BOOST_CHECK_EQUAL(DictRef(g).object("accesses").vector(1).object("name").string(), "edit");
+  BOOST_CHECK_EQUAL(DictRef(g).object("accesses").size(), 3);
+  BOOST_CHECK(!DictRef(g).error());
+  
+  // borrowed.
+  BOOST_CHECK_EQUAL(DictRef(g).object("accesses").get(), Dict::getGenericPtr(Dict::getObjectPtr(g), "accesses"));
+  
+  // shared.
+  auto shared = std::make_shared<const DictG>(complexObj);
+  auto accesses = DictRef(shared).object("accesses");
+  BOOST_CHECK_EQUAL(accesses.get(), Dict::getGenericPtr(Dict::getObjectPtr(*shared), "accesses"));
+  shared.reset();
+  BOOST_CHECK_EQUAL(accesses.vector(0).object("name").string(), "view");
+  
+  BOOST_CHECK(DictRef(std::optional<DictG>()).error());
+  
+}
+
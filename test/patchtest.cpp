@@ -0,0 +1,218 @@
+/*
+  patchtest.cpp
+  
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+  
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+ 
+  https://github.com/visualopsholdings/dict
+*/
+
+
+#include "dict.hpp"
+
+#include <iostream>
+
+#define BOOST_AUTO_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace vops;
+
+DictG parse(const string &s) {
+  return *Dict::parseString(s);
+}
+
+string patched(const string &doc, const string &patch) {
+  auto g = parse(doc);
+  if (!Dict::applyPatch(g, *Dict::getVector(parse(patch)))) {
+    return "failed";
+  }
+  return Dict::toString(g, false);
+}
+
+BOOST_AUTO_TEST_CASE( addOp )
+{
+  cout << "=== addOp ===" << endl;
+  
+  BOOST_CHECK_EQUAL(patched("{\"foo\":\"bar\"}", "[{\"op\":\"add\",\"path\":\"/baz\",\"value\":\"qux\"}]"), 
+    "{\"foo\":\"bar\",\"baz\":\"qux\"}");
+  BOOST_CHECK_EQUAL(patched("{\"foo\":[\"bar\",\"baz\"]}", "[{\"op\":\"add\",\"path\":\"/foo/1\",\"value\":\"qux\"}]"), 
+    "{\"foo\":[\"bar\",\"qux\",\"baz\"]}");
+  BOOST_CHECK_EQUAL(patched("{\"foo\":[\"bar\"]}", "[{\"op\":\"add\",\"path\":\"/foo/-\",\"value\":[\"abc\"]}]"), 
+    "{\"foo\":[\"bar\",[\"abc\"]]}");
+  BOOST_CHECK_EQUAL(patched("{\"foo\":\"bar\"}", "[{\"op\":\"add\",\"path\":\"/baz/bat\",\"value\":\"qux\"}]"), "failed");
+  
+}
+
+BOOST_AUTO_TEST_CASE( removeOp )
+{
+  cout << "=== removeOp ===" << endl;
+  
+  BOOST_CHECK_EQUAL(patched("{\"baz\":\"qux\",\"foo\":\"bar\"}", "[{\"op\":\"remove\",\"path\":\"/baz\"}]"), 
+    "{\"foo\":\"bar\"}");
+  BOOST_CHECK_EQUAL(patched("{\"foo\":[\"bar\",\"qux\",\"baz\"]}", "[{\"op\":\"remove\",\"path\":\"/foo/1\"}]"), 
+    "{\"foo\":[\"bar\",\"baz\"]}");
+  BOOST_CHECK_EQUAL(patched("{\"foo\":\"bar\"}", "[{\"op\":\"remove\",\"path\":\"/baz\"}]"), "failed");
+  
+}
+
+BOOST_AUTO_TEST_CASE( replaceOp )
+{
+  cout << "=== replaceOp ===" << endl;
+  
+  BOOST_CHECK_EQUAL(patched("{\"baz\":\"qux\",\"foo\":\"bar\"}", "[{\"op\":\"replace\",\"path\":\"/baz\",\"value\":\"boo\"}]"), 
+    "{\"baz\":\"boo\",\"foo\":\"bar\"}");
+  BOOST_CHECK_EQUAL(patched("{\"foo\":\"bar\"}", "[{\"op\":\"replace\",\"path\":\"/baz\",\"value\":\"boo\"}]"), "failed");
+  
+}
+
+BOOST_AUTO_TEST_CASE( moveAndCopy )
+{
+  cout << "=== moveAndCopy ===" << endl;
+  
+  BOOST_CHECK_EQUAL(patched("{\"foo\":{\"bar\":\"baz\",\"waldo\":\"fred\"},\"qux\":{\"corge\":\"grault\"}}", 
+    "[{\"op\":\"move\",\"from\":\"/foo/waldo\",\"path\":\"/qux/thud\"}]"), 
+    "{\"foo\":{\"bar\":\"baz\"},\"qux\":{\"corge\":\"grault\",\"thud\":\"fred\"}}");
+  BOOST_CHECK_EQUAL(patched("{\"foo\":[\"all\",\"grass\",\"cows\",\"eat\"]}", 
+    "[{\"op\":\"move\",\"from\":\"/foo/1\",\"path\":\"/foo/3\"}]"), 
+    "{\"foo\":[\"all\",\"cows\",\"eat\",\"grass\"]}");
+  BOOST_CHECK_EQUAL(patched("{\"foo\":{\"bar\":1}}", 
+    "[{\"op\":\"copy\",\"from\":\"/foo\",\"path\":\"/baz\"}]"), 
+    "{\"foo\":{\"bar\":1},\"baz\":{\"bar\":1}}");
+  BOOST_CHECK_EQUAL(patched("{\"foo\":{\"bar\":1}}", 
+    "[{\"op\":\"move\",\"from\":\"/foo\",\"path\":\"/foo/bar/x\"}]"), "failed");
+  
+}
+
+BOOST_AUTO_TEST_CASE( testOp )
+{
+  cout << "=== testOp ===" << endl;
+  
+  BOOST_CHECK_EQUAL(patched("{\"baz\":\"qux\",\"foo\":[\"a\",2,\"c\"]}", 
+    "[{\"op\":\"test\",\"path\":\"/baz\",\"value\":\"qux\"},{\"op\":\"test\",\"path\":\"/foo/1\",\"value\":2}]"), 
+    "{\"baz\":\"qux\",\"foo\":[\"a\",2,\"c\"]}");
+  BOOST_CHECK_EQUAL(patched("{\"baz\":\"qux\"}", "[{\"op\":\"test\",\"path\":\"/baz\",\"value\":\"bar\"}]"), "failed");
+  BOOST_CHECK_EQUAL(patched("{\"a\":{\"x\":1,\"y\":[1,2]}}", "[{\"op\":\"test\",\"path\":\"/a\",\"value\":{\"y\":[1,2],\"x\":1.0}}]"), 
+    "{\"a\":{\"x\":1,\"y\":[1,2]}}");
+  
+}
+
+BOOST_AUTO_TEST_CASE( rollback )
+{
+  cout << "=== rollback ===" << endl;
+  
+  string doc = "{\"a\":1,\"b\":{\"c\":[1,2,3]},\"d\":\"e\"}";
+  auto g = parse(doc);
+  auto ops = *Dict::getVector(parse("["
+    "{\"op\":\"add\",\"path\":\"/x\",\"value\":1},"
+    "{\"op\":\"remove\",\"path\":\"/a\"},"
+    "{\"op\":\"replace\",\"path\":\"/b/c/1\",\"value\":\"two\"},"
+    "{\"op\":\"add\",\"path\":\"/b/c/0\",\"value\":0},"
+    "{\"op\":\"remove\",\"path\":\"/b/c/3\"},"
+    "{\"op\":\"move\",\"from\":\"/d\",\"path\":\"/b/d\"},"
+    "{\"op\":\"copy\",\"from\":\"/b\",\"path\":\"/f\"},"
+    "{\"op\":\"add\",\"path\":\"\",\"value\":{\"all\":\"new\"}},"
+    "{\"op\":\"test\",\"path\":\"/all\",\"value\":\"old\"}"
+  "]"));
+  BOOST_CHECK(!Dict::applyPatch(g, ops));
+  BOOST_CHECK_EQUAL(Dict::toString(g, false), doc);
+  
+  // without the test it's fine.
+  ops.pop_back();
+  BOOST_CHECK(Dict::applyPatch(g, ops));
+  BOOST_CHECK_EQUAL(Dict::toString(g, false), "{\"all\":\"new\"}");
+
+}
+
+BOOST_AUTO_TEST_CASE( moveRollback )
+{
+  cout << "=== moveRollback ===" << endl;
+  
+  // moves over keys, into vectors and out of them, and one that can't be added.
+  string doc = "{\"a\":\"one\",\"b\":{\"c\":[1,2,3]},\"d\":\"e\",\"f\":{\"g\":true}}";
+  auto g = parse(doc);
+  auto ops = *Dict::getVector(parse("["
+    "{\"op\":\"move\",\"from\":\"/a\",\"path\":\"/d\"},"
+    "{\"op\":\"move\",\"from\":\"/b/c/0\",\"path\":\"/b/c/2\"},"
+    "{\"op\":\"move\",\"from\":\"/f\",\"path\":\"/b/c/1\"},"
+    "{\"op\":\"move\",\"from\":\"/b\",\"path\":\"/x\"},"
+    "{\"op\":\"move\",\"from\":\"/d\",\"path\":\"/nothing/here\"}"
+  "]"));
+  BOOST_CHECK(!Dict::applyPatch(g, ops));
+  BOOST_CHECK_EQUAL(Dict::toString(g, false), doc);
+  
+  ops.pop_back();
+  BOOST_CHECK(Dict::applyPatch(g, ops));
+  BOOST_CHECK_EQUAL(Dict::toString(g, false), "{\"d\":\"one\",\"x\":{\"c\":[2,{\"g\":true},3,1]}}");
+
+}
+
+BOOST_AUTO_TEST_CASE( moveInPlace )
+{
+  cout << "=== moveInPlace ===" << endl;
+  
+  // the string itself is moved, not copied.
+  auto g = parse("{\"a\":{\"b\":\"a string that is too long to be inside the std::string\"},\"c\":[]}");
+  auto before = Dict::getStringView(*Dict::find_pointer_ptr(g, Dict::Pointer("/a/b")))->data();
+  BOOST_CHECK(Dict::applyPatch(g, *Dict::getVector(parse("[{\"op\":\"move\",\"from\":\"/a/b\",\"path\":\"/c/0\"}]"))));
+  BOOST_CHECK_EQUAL((void *)Dict::getStringView(*Dict::find_pointer_ptr(g, Dict::Pointer("/c/0")))->data(), (void *)before);
+  
+}
+
+BOOST_AUTO_TEST_CASE( exactNumbers )
+{
+  cout << "=== exactNumbers ===" << endl;
+  
+  BOOST_CHECK(!Dict::equals(DictG((int64_t)9007199254740993), DictG((int64_t)9007199254740992)));
+  BOOST_CHECK(!Dict::equals(DictG((int64_t)9007199254740993), DictG(9007199254740992.0)));
+  BOOST_CHECK(Dict::equals(DictG((int64_t)9007199254740992), DictG(9007199254740992.0)));
+  BOOST_CHECK(Dict::equals(DictG(1.0), DictG((int64_t)1)));
+  BOOST_CHECK(!Dict::equals(DictG(1.5), DictG((int64_t)1)));
+  BOOST_CHECK(!Dict::equals(DictG(1e300), DictG(INT64_MAX)));
+  BOOST_CHECK(!Dict::equals(DictG(9223372036854775808.0), DictG(INT64_MAX)));
+  
+}
+
+string merged(const string &doc, const string &patch) {
+  auto g = parse(doc);
+  Dict::mergePatch(g, parse(patch));
+  return Dict::toString(g, false);
+}
+
+BOOST_AUTO_TEST_CASE( mergePatch )
+{
+  cout << "=== mergePatch ===" << endl;
+  
+  // from RFC 7386.
+  BOOST_CHECK_EQUAL(merged("{\"a\":\"b\"}", "{\"a\":\"c\"}"), "{\"a\":\"c\"}");
+  BOOST_CHECK_EQUAL(merged("{\"a\":\"b\"}", "{\"b\":\"c\"}"), "{\"a\":\"b\",\"b\":\"c\"}");
+  BOOST_CHECK_EQUAL(merged("{\"a\":\"b\"}", "{\"a\":null}"), "{}");
+  BOOST_CHECK_EQUAL(merged("{\"a\":\"b\",\"b\":\"c\"}", "{\"a\":null}"), "{\"b\":\"c\"}");
+  BOOST_CHECK_EQUAL(merged("{\"a\":[\"b\"]}", "{\"a\":\"c\"}"), "{\"a\":\"c\"}");
+  BOOST_CHECK_EQUAL(merged("{\"a\":\"c\"}", "{\"a\":[\"b\"]}"), "{\"a\":[\"b\"]}");
+  BOOST_CHECK_EQUAL(merged("{\"a\":{\"b\":\"c\"}}", "{\"a\":{\"b\":\"d\",\"c\":null}}"), "{\"a\":{\"b\":\"d\"}}");
+  BOOST_CHECK_EQUAL(merged("{\"a\":[{\"b\":\"c\"}]}", "{\"a\":[1]}"), "{\"a\":[1]}");
+  BOOST_CHECK_EQUAL(merged("[\"a\",\"b\"]", "[\"c\",\"d\"]"), "[\"c\",\"d\"]");
+  BOOST_CHECK_EQUAL(merged("{\"a\":\"b\"}", "[\"c\"]"), "[\"c\"]");
+  BOOST_CHECK_EQUAL(merged("{\"e\":null}", "{\"a\":1}"), "{\"e\":null,\"a\":1}");
+  BOOST_CHECK_EQUAL(merged("[1,2]", "{\"a\":\"b\",\"c\":null}"), "{\"a\":\"b\"}");
+  BOOST_CHECK_EQUAL(merged("{}", "{\"a\":{\"bb\":{\"ccc\":null}}}"), "{\"a\":{\"bb\":{}}}");
+  
+}
+
+BOOST_AUTO_TEST_CASE( deepMerge )
+{
+  cout << "=== deepMerge ===" << endl;
+  
+  vector<DictG> layers;
+  layers.push_back(parse("{\"db\":{\"host\":\"localhost\",\"port\":27017},\"debug\":false,\"cache\":{\"size\":10}}"));
+  layers.push_back(parse("{\"db\":{\"host\":\"prod\"},\"cache\":null}"));
+  layers.push_back(parse("{\"debug\":true,\"extra\":{\"a\":1}}"));
+  auto g = Dict::deepMerge(std::move(layers));
+  BOOST_CHECK_EQUAL(Dict::toString(g, false), "{\"db\":{\"host\":\"prod\",\"port\":27017},\"debug\":true,\"extra\":{\"a\":1}}");
+  
+  BOOST_CHECK(Dict::deepMerge({}).is_null());
+
+}
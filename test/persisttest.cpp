@@ -0,0 +1,235 @@
+/*
+  persisttest.cpp
+  
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+  
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+ 
+  https://github.com/visualopsholdings/dict
+*/
+
+
+#include "dictp.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+
+#define BOOST_AUTO_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace vops;
+
+DictV emptyV;
+auto complexObj = dictO({
+  { "accesses", DictV{
+    dictO({
+      { "name", "view" },
+      { "groups", emptyV },
+      { "users", DictV{"667d0baedfb1ed18430d8ed3"} }
+    }),
+    dictO({
+      { "name", "edit" },
+      { "groups", DictV{"667d0bae39ae84d0890a2141"} },
+      { "users", emptyV }
+    }),
+    dictO({
+      { "name", "exec" },
+      { "groups", emptyV },
+      { "users", DictV{"667d0baedfb1ed18430d8ed3", "667d0baedfb1ed18430d8ed4"} }
+    })
+  }},
+  { "other", dictO({
+      { "a", 1 },
+      { "b", true }
+    })
+  }
+});
+
+BOOST_AUTO_TEST_CASE( roundTrip )
+{
+  cout << "=== roundTrip ===" << endl;
+  
+  DictP p(complexObj);
+  BOOST_CHECK_EQUAL(Dict::toString(p.toG()), Dict::toString(complexObj));
+  
+}
+
+BOOST_AUTO_TEST_CASE( findPath )
+{
+  cout << "=== findPath ===" << endl;
+  
+  DictP p(complexObj);
+  auto users = DictP::find_pointer(p, "/accesses/2/users");
+  BOOST_CHECK(users);
+  BOOST_CHECK_EQUAL(users->getVector()->size(), 2);
+  BOOST_CHECK_EQUAL(Dict(users->toG()).vector(1).string(), "667d0baedfb1ed18430d8ed4");
+  
+  BOOST_CHECK(!DictP::find_pointer(p, "/accesses/3"));
+  BOOST_CHECK(!DictP::find_pointer(p, "/xxx"));
+  
+}
+
+BOOST_AUTO_TEST_CASE( versions )
+{
+  cout << "=== versions ===" << endl;
+  
+  DictP v1(complexObj);
+  auto v2 = DictP::set_at_pointer(v1, "/accesses/1/name", DictP(DictG("write")));
+  BOOST_CHECK(v2);
+  
+  // the old version is untouched.
+  BOOST_CHECK_EQUAL(Dict(DictP::find_pointer(v1, "/accesses/1/name")->toG()).string(), "edit");
+  BOOST_CHECK_EQUAL(Dict(DictP::find_pointer(*v2, "/accesses/1/name")->toG()).string(), "write");
+  
+  // and everything not on the path is shared.
+  BOOST_CHECK(!DictP::same(v1, *v2));
+  BOOST_CHECK(!DictP::same(*DictP::find_pointer(v1, "/accesses"), *DictP::find_pointer(*v2, "/accesses")));
+  BOOST_CHECK(DictP::same(*DictP::find_pointer(v1, "/other"), *DictP::find_pointer(*v2, "/other")));
+  BOOST_CHECK(DictP::same(*DictP::find_pointer(v1, "/accesses/0"), *DictP::find_pointer(*v2, "/accesses/0")));
+  BOOST_CHECK(DictP::same(*DictP::find_pointer(v1, "/accesses/1/groups"), *DictP::find_pointer(*v2, "/accesses/1/groups")));
+  
+  // add a key.
+  auto v3 = DictP::set_at_pointer(*v2, "/other/c", DictP(DictG("new")));
+  BOOST_CHECK(v3);
+  BOOST_CHECK_EQUAL(Dict(v3->toG()).object("other").object("c").string(), "new");
+  BOOST_CHECK(!DictP::find_pointer(*v2, "/other/c"));
+  
+  BOOST_CHECK(!DictP::set_at_pointer(*v2, "/xxx/c", DictP(DictG("new"))));
+  
+  // a failed set doesn't make symbols, one that adds a key does.
+  BOOST_CHECK(!DictP::set_at_pointer(*v2, "/a key nobody sets/c", DictP(DictG("new"))));
+  BOOST_CHECK(!Symbols::global().find("a key nobody sets"));
+  auto v4 = DictP::set_at_pointer(*v2, "/a key somebody sets", DictP(DictG("new")));
+  BOOST_CHECK(v4);
+  BOOST_CHECK(Symbols::global().find("a key somebody sets"));
+  
+  // and it goes when nothing has it.
+  v4 = nullopt;
+  BOOST_CHECK(!Symbols::global().find("a key somebody sets"));
+  
+}
+
+BOOST_AUTO_TEST_CASE( scalars )
+{
+  cout << "=== scalars ===" << endl;
+  
+  DictP p(complexObj);
+  BOOST_CHECK_EQUAL(*Dict::getNum(*DictP::find_pointer(p, "/other/a")->getScalar()), 1);
+  BOOST_CHECK_EQUAL(*Dict::getBool(*DictP::find_pointer(p, "/other/b")->getScalar()), true);
+  BOOST_CHECK_EQUAL(*Dict::getString(*DictP::find_pointer(p, "/accesses/0/name")->getScalar()), "view");
+  BOOST_CHECK(DictP().getScalar()->is_null());
+  BOOST_CHECK(!p.getScalar());
+  
+  BOOST_CHECK(DictP::same(DictP(DictG(1)), DictP(DictG(1))));
+  BOOST_CHECK(!DictP::same(DictP(DictG(1)), DictP(DictG(2))));
+  BOOST_CHECK(!DictP::same(DictP(DictG(1)), DictP(DictG(1.0))));
+  
+}
+
+BOOST_AUTO_TEST_CASE( parse )
+{
+  cout << "=== parse ===" << endl;
+  
+  string json = R"({ "a": [1, -2.5, 1e3, true, false, null, "x\"y\u00e9"], "b": {}, "c": [], "d": 9007199254740993 })";
+  auto p = DictP::parseString(json);
+  BOOST_REQUIRE(p);
+  auto g = Dict::parseString(json);
+  BOOST_REQUIRE(g);
+  BOOST_CHECK_EQUAL(Dict::toString(p->toG()), Dict::toString(*g));
+  BOOST_CHECK_EQUAL(get<int64_t>(DictP::find_pointer(*p, "/d")->getScalar()->variant()), 9007199254740993);
+  
+  // objects and vectors are exactly the size they need to be.
+  BOOST_CHECK_EQUAL(DictP::find_pointer(*p, "/a")->getVector()->capacity(), 7);
+  
+  BOOST_CHECK(!DictP::parseString("{ \"a\": }"));
+  BOOST_CHECK(!DictP::parseString("[1, 2"));
+  BOOST_CHECK(!DictP::parseString("[1] x"));
+  BOOST_CHECK(!DictP::parseString("\"\xff\""));
+  
+  // other formats go through a DictG.
+  auto y = DictP::parseString(json, ".yml");
+  BOOST_REQUIRE(y);
+  BOOST_CHECK_EQUAL(Dict::toString(y->toG()), Dict::toString(*g));
+  
+}
+
+BOOST_AUTO_TEST_CASE( interned )
+{
+  cout << "=== interned ===" << endl;
+  
+  auto p = DictP::parseString("[{ \"name\": \"a\", \"value\": 1 }, { \"name\": \"b\", \"value\": 2 }]");
+  BOOST_CHECK(p);
+  
+  // both objects have the same key.
+  auto v = p->getVector();
+  BOOST_CHECK_EQUAL(v->size(), 2);
+  auto &k1 = (*v)[0].getObject()->begin()->first;
+  auto &k2 = (*v)[1].getObject()->begin()->first;
+  BOOST_CHECK(k1 == k2);
+  BOOST_CHECK_EQUAL(&k1.str(), &k2.str());
+  BOOST_CHECK_EQUAL(k1.str(), "name");
+  
+  BOOST_CHECK(Symbols::global().find("value"));
+  BOOST_CHECK(!Symbols::global().find("a key nobody has ever used"));
+  BOOST_CHECK(!DictP::find_pointer(*p, "/0/a key nobody has ever used"));
+  BOOST_CHECK_EQUAL(Dict(DictP::find_pointer(*p, "/1/name")->toG()).string(), "b");
+  
+  Symbols symbols;
+  auto x = symbols.intern("x");
+  BOOST_CHECK(x == symbols.intern(string("x")));
+  BOOST_CHECK(!(x == symbols.intern("y")));
+  BOOST_CHECK_EQUAL(symbols.size(), 1);
+  {
+    auto x2 = x;
+    auto y = symbols.intern("y");
+    BOOST_CHECK_EQUAL(symbols.size(), 2);
+  }
+  BOOST_CHECK_EQUAL(symbols.size(), 1);
+  x = symbols.intern("z");
+  BOOST_CHECK(!symbols.find("x"));
+  
+  // keys that are only used once don't hang around.
+  auto before = Symbols::global().size();
+  for (int i=0; i<1000; i++) {
+    auto id = DictP::parseString("{ \"id" + to_string(i) + "\": 1 }");
+    BOOST_CHECK(id);
+  }
+  BOOST_CHECK_EQUAL(Symbols::global().size(), before);
+  
+}
+
+BOOST_AUTO_TEST_CASE( parseFile )
+{
+  cout << "=== parseFile ===" << endl;
+  
+  auto dir = filesystem::temp_directory_path() / "persisttest";
+  filesystem::create_directories(dir);
+  {
+    ofstream f(dir / "plain.json");
+    f << "{ \"a\": [1, 2], \"b\": \"x\" }";
+  }
+  {
+    ofstream f(dir / "includes.json");
+    f << "{ \"...\": \"<plain.json>\", \"c\": true }";
+  }
+  
+  // straight into a DictP.
+  auto p = DictP::parseFile((dir / "plain.json").string());
+  BOOST_REQUIRE(p);
+  BOOST_CHECK_EQUAL(Dict::toString(p->toG()), Dict::toString(*Dict::parseFile((dir / "plain.json").string())));
+  
+  // through the includes.
+  auto i = DictP::parseFile((dir / "includes.json").string());
+  BOOST_REQUIRE(i);
+  BOOST_CHECK_EQUAL(Dict(DictP::find_pointer(*i, "/b")->toG()).string(), "x");
+  BOOST_CHECK(DictP::find_pointer(*i, "/c"));
+  BOOST_CHECK(!DictP::find_pointer(*i, "/..."));
+  
+  BOOST_CHECK(!DictP::parseFile((dir / "nothing.json").string()));
+  
+  filesystem::remove_all(dir);
+  
+}
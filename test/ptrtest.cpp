@@ -221,3 +221,150 @@ BOOST_AUTO_TEST_CASE( setComplex )
   BOOST_CHECK_EQUAL(Dict(result).object("accesses").vector(2).object("users").vector(0).string(), "667d0baedfb1ed18430d8ed4");
   
 }
+
+BOOST_AUTO_TEST_CASE( compiled )
+{
+  cout << "=== compiled ===" << endl;
+  
+  Dict::Pointer p(vecPathsPath);
+  BOOST_CHECK(p.valid());
+  BOOST_CHECK_EQUAL(p.size(), 5);
+  BOOST_CHECK_EQUAL(*(p.begin()+1)->index, 1);
+  BOOST_CHECK(!p.begin()->index);
+  
+  BOOST_CHECK_EQUAL(Dict(Dict::find_pointer(vecPaths, p)).string(), "eee");
+  
+  // and again on a different document.
+  auto result = Dict::set_at_pointer(vecPaths, p, "111");
+  BOOST_CHECK_EQUAL(Dict(Dict::find_pointer(*result, p)).string(), "111");
+  
+  BOOST_CHECK(!Dict::find_pointer(objPaths, p));
+
+}
+
+BOOST_AUTO_TEST_CASE( escapes )
+{
+  cout << "=== escapes ===" << endl;
+  
+  auto obj = dictO({
+    { "a/b", "slash" },
+    { "m~n", "tilde" },
+    { "", "empty" }
+  });
+  
+  BOOST_CHECK_EQUAL(Dict(Dict::find_pointer(obj, "/a~1b")).string(), "slash");
+  BOOST_CHECK_EQUAL(Dict(Dict::find_pointer(obj, "/m~0n")).string(), "tilde");
+  BOOST_CHECK_EQUAL(Dict(Dict::find_pointer(obj, "/")).string(), "empty");
+  BOOST_CHECK(!Dict::Pointer("/a~2b").valid());
+  BOOST_CHECK(!Dict::Pointer("a").valid());
+
+}
+
+BOOST_AUTO_TEST_CASE( wholeDocument )
+{
+  cout << "=== wholeDocument ===" << endl;
+  
+  BOOST_CHECK_EQUAL(Dict(Dict::find_pointer(objSimple, "")).object("aaa").string(), "xxx");
+  BOOST_CHECK_EQUAL(Dict(Dict::set_at_pointer(objSimple, "", "xxx")).string(), "xxx");
+
+}
+
+BOOST_AUTO_TEST_CASE( badIndex )
+{
+  cout << "=== badIndex ===" << endl;
+  
+  BOOST_CHECK(!Dict::find_pointer(vecSimple, "/abc"));
+  BOOST_CHECK(!Dict::find_pointer(vecSimple, "/01"));
+  BOOST_CHECK(!Dict::set_at_pointer(vecSimple, "/abc", "111"));
+  
+  // but numbers are fine as keys.
+  auto obj = dictO({ { "01", "x" } });
+  BOOST_CHECK_EQUAL(Dict(Dict::find_pointer(obj, "/01")).string(), "x");
+
+}
+
+BOOST_AUTO_TEST_CASE( findMany )
+{
+  cout << "=== findMany ===" << endl;
+  
+  auto config = dictO({
+    { "config", dictO({
+      { "db", dictO({
+        { "host", "localhost" },
+        { "port", 27017 }
+        })
+      },
+      { "cache", dictO({
+        { "size", 100 }
+        })
+      },
+      { "servers", DictV{ "a", "b" } }
+      })
+    }
+  });
+  
+  auto results = Dict::findPointers(config, { 
+    "/config/db/host", 
+    "/config/db/port", 
+    "/config/cache/size", 
+    "/config/db/user", 
+    "/config/servers/1", 
+    "/config/servers/2", 
+    "/config/db/host/xxx",
+    "/config/db/host",
+    "bad"
+  });
+  BOOST_CHECK_EQUAL(results.size(), 9);
+  BOOST_CHECK_EQUAL(results[0].string(), "localhost");
+  BOOST_CHECK_EQUAL(results[1].num(), 27017);
+  BOOST_CHECK_EQUAL(results[2].num(), 100);
+  BOOST_CHECK_EQUAL(*results[3].error(), "Path: /config/db Err: user not found");
+  BOOST_CHECK_EQUAL(results[4].string(), "b");
+  BOOST_CHECK_EQUAL(*results[5].error(), "Path: /config/servers Err: index 2 is invalid");
+  BOOST_CHECK_EQUAL(*results[6].error(), "Path: /config/db/host Err: only objects and vectors supported");
+  BOOST_CHECK_EQUAL(results[7].string(), "localhost");
+  BOOST_CHECK(results[8].error());
+  
+}
+
+BOOST_AUTO_TEST_CASE( setInPlace )
+{
+  cout << "=== setInPlace ===" << endl;
+  
+  DictG g = vecPaths;
+  BOOST_CHECK(Dict::set_at_pointer_in_place(g, vecPathsPath, "111"));
+  BOOST_CHECK_EQUAL(Dict(g).object("aaa").vector(1).object("bbb").object("ccc").vector(1).string(), "111");
+  BOOST_CHECK_EQUAL(Dict(g).object("aaa").vector(0).string(), "xxx");
+  
+  // add a new key.
+  BOOST_CHECK(Dict::set_at_pointer_in_place(g, "/aaa/1/bbb/new", 42));
+  BOOST_CHECK_EQUAL(Dict(g).object("aaa").vector(1).object("bbb").object("new").num(), 42);
+  
+  // bad paths leave it alone.
+  auto before = Dict::toString(g);
+  BOOST_CHECK(!Dict::set_at_pointer_in_place(g, "/aaa/3/bbb", 42));
+  BOOST_CHECK(!Dict::set_at_pointer_in_place(g, "/xxx/yyy", 42));
+  BOOST_CHECK(!Dict::set_at_pointer_in_place(g, "/aaa/0/yyy", 42));
+  BOOST_CHECK_EQUAL(Dict::toString(g), before);
+
+}
+
+BOOST_AUTO_TEST_CASE( setKeepsOrder )
+{
+  cout << "=== setKeepsOrder ===" << endl;
+  
+  auto result = Dict::set_at_pointer(objSimple, objSimplePath, "111");
+  BOOST_CHECK_EQUAL(Dict::toString(*result, false), "{\"aaa\":\"xxx\",\"bbb\":\"111\",\"ccc\":\"zzz\"}");
+
+}
+
+BOOST_AUTO_TEST_CASE( setMoved )
+{
+  cout << "=== setMoved ===" << endl;
+  
+  DictG g = complexObj;
+  auto result = Dict::set_at_pointer(std::move(g), complexObjPath, DictV{"667d0baedfb1ed18430d8ed4"});
+  BOOST_CHECK_EQUAL(Dict(result).object("accesses").vector(2).object("users").size(), 1);
+  BOOST_CHECK_EQUAL(Dict(result).object("accesses").vector(0).object("name").string(), "view");
+  
+}
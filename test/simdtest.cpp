@@ -0,0 +1,230 @@
+/*
+  simdtest.cpp
+  
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+  
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+ 
+  https://github.com/visualopsholdings/dict
+*/
+
+
+#include "dict.hpp"
+#include "dictjson.hpp"
+
+#include <iostream>
+#include <sstream>
+#include <random>
+#include <thread>
+#include <atomic>
+
+#define BOOST_AUTO_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace vops;
+
+const vector<string> corpus = {
+  R"({ "a": 1, "b": [ true, false, null ], "c": { "d": "e" } })",
+  R"([ -0, 0, 12, -12, 1.5, -2.5e3, 1E-2, 9223372036854775807, 92233720368547758070 ])",
+  R"({ "esc": "tab\t nl\n quote\" back\\ slash\/ \u00e9 \ud83d\ude00", "utf8": "héllo wörld 😀" })",
+  R"({ "backslashes at the end \\": "\\\\", "\\\"": "\"\\" })",
+  R"({ "empty": {}, "emptyv": [], "nested": [[[[{}]]]], "": "" })",
+  "  {\"ws\"\t:\n[ 1 ,\r\n2 ]\n}  ",
+  "\"just a string\"",
+  "42"
+};
+
+string longDoc() {
+
+  // long enough to go over lots of blocks with strings crossing them.
+  stringstream ss;
+  ss << "[";
+  for (int i=0; i<500; i++) {
+    if (i > 0) {
+      ss << ",";
+    }
+    ss << "{\"id\":" << i << ",\"name\":\"item \\\"" << i << "\\\" with a long string \\\\ that goes on\",\"v\":[1.5,true,null]}";
+  }
+  ss << "]";
+  return ss.str();
+  
+}
+
+void checkSame(const string &json) {
+
+  Dict::setJSONParser(Dict::JSONParser::Rfl);
+  auto expected = Dict::parseString(json);
+  BOOST_CHECK(expected);
+  
+  Dict::setJSONParser(Dict::JSONParser::Simd);
+  auto g = Dict::parseString(json);
+  BOOST_CHECK(g);
+  
+  BOOST_CHECK(Dict::equals(*g, *expected));
+  BOOST_CHECK_EQUAL(Dict::toString(*g), Dict::toString(*expected));
+  
+}
+
+BOOST_AUTO_TEST_CASE( sameAsRfl )
+{
+  cout << "=== sameAsRfl ===" << endl;
+  
+  auto parser = Dict::getJSONParser();
+  cout << "best kernel is " << Dict::simdKernel() << endl;
+  for (auto k: { "avx2", "sse4.2", "scalar" }) {
+    if (!Dict::setSimdKernel(k)) {
+      continue;
+    }
+    cout << "checking " << k << endl;
+    for (auto &json: corpus) {
+      checkSame(json);
+    }
+    checkSame(longDoc());
+  }
+  Dict::setJSONParser(parser);
+  
+}
+
+BOOST_AUTO_TEST_CASE( streamAndFile )
+{
+  cout << "=== streamAndFile ===" << endl;
+  
+  auto parser = Dict::getJSONParser();
+  Dict::setJSONParser(Dict::JSONParser::Simd);
+  
+  stringstream ss(corpus[0]);
+  auto g = Dict::parseStream(ss);
+  BOOST_CHECK(g);
+  BOOST_CHECK_EQUAL(Dict(g).object("c").object("d").string(), "e");
+  
+  std::filesystem::path path = "../dict-src/test";
+  if (!std::filesystem::exists(path)) {
+    path = "../test";
+  }
+  auto f = Dict::parseFile(path / "include.json");
+  BOOST_CHECK(f);
+  
+  Dict::setJSONParser(Dict::JSONParser::Rfl);
+  BOOST_CHECK(Dict::equals(*f, *Dict::parseFile(path / "include.json")));
+  Dict::setJSONParser(parser);
+  
+}
+
+BOOST_AUTO_TEST_CASE( simdBad )
+{
+  cout << "=== simdBad ===" << endl;
+  
+  for (auto json: { "", "{", "{ \"a\": }", "[1, 2,]", "[1 2]", "\"abc", "01", "[1] x", "tru", "truex", 
+      "{ \"a\" 1 }", "[\"a\"b]", "\"\\ud800\"", "\"a\x01\"", "\"\xff\"", "\"\xc3\"", "{,}", "[,1]", "nul" }) {
+    BOOST_CHECK_MESSAGE(!Dict::parseSimd(json), json);
+  }
+  
+}
+
+BOOST_AUTO_TEST_CASE( stringKernels )
+{
+  cout << "=== stringKernels ===" << endl;
+  
+  const vector<string> good = { "", "abc", "héllo wörld", "日本語のテキスト", "😀 emoji 🎉", 
+    "\xc2\x80", "\xdf\xbf", "\xe0\xa0\x80", "\xed\x9f\xbf", "\xee\x80\x80", "\xf0\x90\x80\x80", "\xf4\x8f\xbf\xbf" };
+  const vector<string> bad = { "\xff", "\x80", "\xc3", "\xc0\x80", "\xc1\xbf", "\xe0\x80\x80", "\xe0\x9f\xbf", 
+    "\xed\xa0\x80", "\xed\xbf\xbf", "\xf0\x80\x80\x80", "\xf0\x8f\xbf\xbf", "\xf4\x90\x80\x80", "\xf5\x80\x80\x80", 
+    "\xe6\x97", "\xf0\x9f\x98", "a\x80" "b", "\xc3\xa9\xa9" };
+  
+  // random strings that are mostly UTF-8, with a bit of everything else.
+  mt19937 rng(42);
+  vector<string> randoms;
+  for (int i=0; i<2000; i++) {
+    string s;
+    int len = rng() % 100;
+    for (int j=0; j<len; j++) {
+      switch (rng() % 8) {
+      case 0: s += "é"; break;
+      case 1: s += "語"; break;
+      case 2: s += "😀"; break;
+      case 3: s += char(rng() % 256); break;
+      case 4: s += "\"\\\n"[rng() % 3]; break;
+      default: s += char('a' + rng() % 26);
+      }
+    }
+    randoms.push_back(s);
+  }
+  
+  auto best = Dict::simdKernel();
+  for (auto k: { "avx2", "sse4.2", "scalar" }) {
+    if (!Dict::setSimdKernel(k)) {
+      continue;
+    }
+    cout << "checking " << k << endl;
+    
+    // at every offset so they cross the SIMD blocks.
+    for (int pad=0; pad<40; pad++) {
+      string prefix(pad, 'x');
+      for (auto &s: good) {
+        BOOST_CHECK_MESSAGE(json::validUTF8(prefix + s), k << " " << pad << " " << s);
+        BOOST_CHECK(json::validUTF8(prefix + s + prefix));
+      }
+      for (auto &s: bad) {
+        BOOST_CHECK_MESSAGE(!json::validUTF8(prefix + s), k << " " << pad << " " << s);
+        BOOST_CHECK(!json::validUTF8(prefix + s + prefix));
+      }
+      string escape = prefix + "\"" + prefix;
+      BOOST_CHECK_EQUAL(json::findEscape(escape, 0), pad);
+      BOOST_CHECK_EQUAL(json::findEscape(escape, pad + 1), escape.size());
+    }
+    
+    for (auto &s: randoms) {
+      BOOST_CHECK_EQUAL(json::validUTF8(s), json::validUTF8Scalar(s));
+      for (size_t i=0; i<s.size(); i += 7) {
+        BOOST_CHECK_EQUAL(json::findEscape(s, i), json::findEscapeScalar(s, i));
+      }
+    }
+    
+    // and toString escapes them so they read back the same.
+    for (auto &s: randoms) {
+      if (json::validUTF8Scalar(s)) {
+        auto g = Dict::parseString(Dict::toString(DictG(s)));
+        BOOST_CHECK(g && *Dict::getStringView(*g) == s);
+      }
+    }
+  }
+  Dict::setSimdKernel(best);
+  
+}
+
+BOOST_AUTO_TEST_CASE( kernelThreads )
+{
+  cout << "=== kernelThreads ===" << endl;
+  
+  // change the kernel while other threads are using it.
+  auto best = Dict::simdKernel();
+  auto json = longDoc();
+  auto expected = Dict::parseSimd(json);
+  BOOST_REQUIRE(expected);
+  
+  atomic<bool> done = false;
+  atomic<int> wrong = 0;
+  vector<thread> threads;
+  for (int i=0; i<2; i++) {
+    threads.push_back(thread([&]() {
+      while (!done) {
+        auto g = Dict::parseSimd(json);
+        if (!g || !Dict::equals(*g, *expected) || !json::validUTF8("héllo") || json::findEscape("ab\"", 0) != 2) {
+          wrong++;
+        }
+      }
+    }));
+  }
+  for (int i=0; i<2000; i++) {
+    Dict::setSimdKernel(i % 2 ? "scalar" : best);
+  }
+  done = true;
+  for (auto &t: threads) {
+    t.join();
+  }
+  Dict::setSimdKernel(best);
+  BOOST_CHECK_EQUAL(wrong, 0);
+  
+}
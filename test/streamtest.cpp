@@ -0,0 +1,275 @@
+/*
+  streamtest.cpp
+  
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+  
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+ 
+  https://github.com/visualopsholdings/dict
+*/
+
+
+#include "dict.hpp"
+
+#include <rfl/json.hpp>
+#include <iostream>
+#include <sstream>
+
+#define BOOST_AUTO_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace vops;
+
+const string arrayJSON = R"( [
+  { "name": "a, with [brackets] and \"quotes\" \\", "v": [1, 2, { "x": "]" }] },
+  "just a string",
+  42,
+  [ [], {} ],
+  null
+] )";
+
+BOOST_AUTO_TEST_CASE( streamElements )
+{
+  cout << "=== streamElements ===" << endl;
+  
+  // tiny chunks so elements cross them.
+  for (size_t chunk: { 1, 3, 7, 65536 }) {
+    stringstream ss(arrayJSON);
+    vector<DictG> elements;
+    BOOST_CHECK(Dict::streamArray(ss, [&elements](DictG &&g) {
+      elements.push_back(std::move(g));
+      return true;
+    }, chunk));
+    BOOST_CHECK_EQUAL(elements.size(), 5);
+    BOOST_CHECK(Dict::equals(DictG(elements), *Dict::parseString(arrayJSON)));
+  }
+  
+}
+
+BOOST_AUTO_TEST_CASE( streamStop )
+{
+  cout << "=== streamStop ===" << endl;
+  
+  stringstream ss(arrayJSON);
+  int count = 0;
+  BOOST_CHECK(Dict::streamArray(ss, [&count](DictG &&g) {
+    count++;
+    return count < 2;
+  }));
+  BOOST_CHECK_EQUAL(count, 2);
+  
+}
+
+BOOST_AUTO_TEST_CASE( streamBad )
+{
+  cout << "=== streamBad ===" << endl;
+  
+  auto none = [](DictG &&g) { return true; };
+  
+  stringstream empty("[ ]");
+  BOOST_CHECK(Dict::streamArray(empty, none));
+  
+  for (auto json: { "", "{}", "[1, 2", "[1,]", "[1 2]", "[1] x", "[}" }) {
+    stringstream ss(json);
+    BOOST_CHECK_MESSAGE(!Dict::streamArray(ss, none), json);
+  }
+  
+}
+
+BOOST_AUTO_TEST_CASE( ndjson )
+{
+  cout << "=== ndjson ===" << endl;
+  
+  DictV records;
+  for (int i=0; i<1000; i++) {
+    records.push_back(dictO({ { "id", i }, { "name", "record\n" + to_string(i) } }));
+  }
+  stringstream out;
+  BOOST_CHECK(Dict::writeNDJSON(out, records));
+  
+  // small chunks so there are lots of them.
+  for (int threads: { 1, 2, 4 }) {
+    stringstream in(out.str());
+    DictV read;
+    BOOST_CHECK(Dict::readNDJSON(in, [&read](DictG &&g) {
+      read.push_back(std::move(g));
+      return true;
+    }, threads, 1000));
+    BOOST_CHECK(Dict::equals(DictG(read), DictG(records)));
+  }
+  
+  // a stream that can't be written to.
+  stringstream bad;
+  bad.setstate(ios::badbit);
+  BOOST_CHECK(!Dict::writeNDJSON(bad, records));
+  
+}
+
+BOOST_AUTO_TEST_CASE( ndjsonLines )
+{
+  cout << "=== ndjsonLines ===" << endl;
+  
+  stringstream in("{ \"a\": 1 }\r\n\n   \n[1, 2]\n\"last\"");
+  auto records = Dict::readNDJSON(in);
+  BOOST_CHECK(records);
+  BOOST_CHECK_EQUAL(records->size(), 3);
+  BOOST_CHECK_EQUAL(Dict((*records)[2]).string(), "last");
+  
+  for (int threads: { 1, 2 }) {
+    stringstream bad("{ \"a\": 1 }\n{ bad }\n{ \"a\": 2 }\n");
+    int count = 0;
+    BOOST_CHECK(!Dict::readNDJSON(bad, [&count](DictG &&g) {
+      count++;
+      return true;
+    }, threads));
+    BOOST_CHECK_EQUAL(count, 1);
+  }
+  
+  // lines much longer than the chunk.
+  string big = "{ \"s\": \"" + string(100, 'x') + "\" }";
+  for (int threads: { 1, 2 }) {
+    stringstream in("{ \"a\": 1 }\n" + big + "\n" + big + "\n{ \"a\": 2 }");
+    vector<DictG> got;
+    BOOST_CHECK(Dict::readNDJSON(in, [&got](DictG &&g) {
+      got.push_back(std::move(g));
+      return true;
+    }, threads, 16));
+    BOOST_CHECK_EQUAL(got.size(), 4);
+    BOOST_CHECK_EQUAL(Dict::getStringG(got[1], "s")->size(), 100);
+  }
+  
+}
+
+const string writeJSON = R"({ 
+  "name": "a \"quoted\" \\ string\nwith a newline and a \t",
+  "v": [1, -2, true, false, null, { "x": [] }, {}],
+  "obj": { "a": { "b": [ [1, 2], [] ] } },
+  "utf8": "héllo wörld"
+})";
+
+BOOST_AUTO_TEST_CASE( writeSame )
+{
+  cout << "=== writeSame ===" << endl;
+  
+  auto g = Dict::parseString(writeJSON);
+  BOOST_CHECK(g);
+  
+  for (auto pretty: { true, false }) {
+    stringstream ss;
+    BOOST_CHECK(Dict::write(*g, ss, pretty));
+    BOOST_CHECK_EQUAL(ss.str(), Dict::toString(*g, pretty));
+  }
+  
+  // doubles might be written differently, but they read back the same.
+  auto d = Dict::parseString("[1.5, 0.1, 3.0, 1e300, -2.5e-10]");
+  BOOST_CHECK(d);
+  stringstream ss;
+  BOOST_CHECK(Dict::write(*d, ss, false));
+  cout << ss.str() << endl;
+  auto d2 = Dict::parseString(ss.str());
+  BOOST_CHECK(d2);
+  BOOST_CHECK_EQUAL(Dict::toString(*d), Dict::toString(*d2));
+  BOOST_CHECK(holds_alternative<double>(Dict::getVector(*d2)->at(2).variant()));
+  
+  // and so do control characters.
+  DictG c = string("\x01\x1f\x7f");
+  stringstream cs;
+  BOOST_CHECK(Dict::write(c, cs));
+  BOOST_CHECK_EQUAL(cs.str(), "\"\\u0001\\u001f\x7f\"");
+  BOOST_CHECK(Dict::equals(*Dict::parseString(cs.str()), c));
+  
+}
+
+BOOST_AUTO_TEST_CASE( writeNumbers )
+{
+  cout << "=== writeNumbers ===" << endl;
+  
+  // doubles come out just like they did with reflect-cpp.
+  vector<pair<double, string>> nums = {
+    { 1e5, "100000.0" }, { 1e-7, "1e-7" }, { 1e-6, "0.000001" }, { 0.1, "0.1" }, { 1.5, "1.5" }, 
+    { 3.0, "3.0" }, { -2.5e-10, "-2.5e-10" }, { 123456.789, "123456.789" }, { 1e20, "100000000000000000000.0" }, 
+    { 1e21, "1e21" }, { 1.5e300, "1.5e300" }, { 0.0, "0.0" }, { 5e-324, "5e-324" }, 
+    { 1.7976931348623157e308, "1.7976931348623157e308" }
+  };
+  for (auto &n: nums) {
+    BOOST_CHECK_EQUAL(Dict::toString(DictG(n.first), false), n.second);
+    BOOST_CHECK_EQUAL(Dict::toString(DictG(n.first), false), rfl::json::write(DictG(n.first)));
+  }
+  
+}
+
+BOOST_AUTO_TEST_CASE( writeChunks )
+{
+  cout << "=== writeChunks ===" << endl;
+  
+  auto g = Dict::parseString(writeJSON);
+  BOOST_CHECK(g);
+  auto all = Dict::toString(*g, false);
+  
+  for (size_t chunk: { 1, 3, 7, 65536 }) {
+    string out;
+    size_t biggest = 0;
+    BOOST_CHECK(Dict::write(*g, [&out, &biggest](string_view c) {
+      out += c;
+      biggest = max(biggest, c.size());
+      return true;
+    }, false, ".json", chunk));
+    BOOST_CHECK_EQUAL(out, all);
+    BOOST_CHECK(biggest <= chunk);
+  }
+  
+  // into our own buffer.
+  char buf[16];
+  string out;
+  BOOST_CHECK(Dict::write(*g, buf, [&out, &buf](string_view c) {
+    BOOST_CHECK(c.data() == buf);
+    out += c;
+    return true;
+  }, false));
+  BOOST_CHECK_EQUAL(out, all);
+  
+}
+
+BOOST_AUTO_TEST_CASE( writeStop )
+{
+  cout << "=== writeStop ===" << endl;
+  
+  auto g = Dict::parseString(writeJSON);
+  BOOST_CHECK(g);
+  
+  int chunks = 0;
+  BOOST_CHECK(!Dict::write(*g, [&chunks](string_view c) {
+    chunks++;
+    return chunks < 2;
+  }, false, ".json", 8));
+  BOOST_CHECK_EQUAL(chunks, 2);
+  
+  stringstream ss;
+  BOOST_CHECK(!Dict::write(*g, ss, false, ".xml"));
+  
+}
+
+BOOST_AUTO_TEST_CASE( writeYAML )
+{
+  cout << "=== writeYAML ===" << endl;
+  
+  auto g = Dict::parseString(R"({ "a": 1, "b": [ "x", { "c": true, "d": [] }, [ 1, 2 ] ], "e": { "f": null }, "g": {} })");
+  BOOST_CHECK(g);
+  stringstream ss;
+  BOOST_CHECK(Dict::write(*g, ss, true, ".yml"));
+  cout << ss.str();
+  BOOST_CHECK_EQUAL(ss.str(), 
+    "\"a\": 1\n"
+    "\"b\":\n"
+    "  - \"x\"\n"
+    "  - \"c\": true\n"
+    "    \"d\": []\n"
+    "  - - 1\n"
+    "    - 2\n"
+    "\"e\":\n"
+    "  \"f\": null\n"
+    "\"g\": {}\n");
+
+}
@@ -0,0 +1,130 @@
+/*
+  tapetest.cpp
+  
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+  
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+ 
+  https://github.com/visualopsholdings/dict
+*/
+
+
+#include "dicttape.hpp"
+
+#include <iostream>
+
+#define BOOST_AUTO_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace vops;
+
+const string complexJSON = R"({
+  "accesses": [
+    { "name": "view", "groups": [], "users": [ "667d0baedfb1ed18430d8ed3" ] },
+    { "name": "edit", "groups": [ "667d0bae39ae84d0890a2141" ], "users": [] },
+    { "name": "exec", "groups": [], "users": [ "667d0baedfb1ed18430d8ed3", "667d0baedfb1ed18430d8ed4" ] }
+  ],
+  "other": { "a": 1, "b": true, "c": null, "d": -2.5e3, "e": "tab\there \u00e9 \ud83d\ude00 \"q\"" }
+})";
+
+BOOST_AUTO_TEST_CASE( sameAsG )
+{
+  cout << "=== sameAsG ===" << endl;
+  
+  auto tape = Dict::parseTape(complexJSON);
+  BOOST_CHECK(tape);
+  auto g = Dict::parseString(complexJSON);
+  BOOST_CHECK(g);
+  BOOST_CHECK(Dict::equals(tape->toG(), *g));
+  BOOST_CHECK_EQUAL(Dict::toString(tape->toG()), Dict::toString(*g));
+  
+}
+
+BOOST_AUTO_TEST_CASE( getters )
+{
+  cout << "=== getters ===" << endl;
+  
+  auto tape = Dict::parseTape(complexJSON);
+  BOOST_CHECK(tape);
+  
+  auto other = tape->root().object("other");
+  BOOST_CHECK_EQUAL(*other.getFirstKey(), "a");
+  BOOST_CHECK_EQUAL(*other.object("a").getNum(), 1);
+  BOOST_CHECK(*other.object("b").getBool());
+  BOOST_CHECK(other.object("c").type() == DictTape::Type::Null);
+  BOOST_CHECK(other.object("d").type() == DictTape::Type::Double);
+  BOOST_CHECK_EQUAL(*other.object("e").getStringView(), "tab\there \u00e9 \U0001F600 \"q\"");
+  BOOST_CHECK(!other.object("a").getStringView());
+  
+  auto users = tape->find_pointer("/accesses/2/users/1");
+  BOOST_CHECK(users);
+  BOOST_CHECK_EQUAL(*users->getStringView(), "667d0baedfb1ed18430d8ed4");
+  BOOST_CHECK(!tape->find_pointer("/accesses/3"));
+  BOOST_CHECK(!tape->find_pointer("/other/x"));
+  
+}
+
+BOOST_AUTO_TEST_CASE( tapeMonad )
+{
+  cout << "=== tapeMonad ===" << endl;
+  
+  auto tape = Dict::parseTape(complexJSON);
+  BOOST_CHECK(tape);
+  auto root = tape->root();
+  
+  BOOST_CHECK_EQUAL(root.object("accesses").vector(1).object("name").string(), "edit");
+  BOOST_CHECK_EQUAL(root.object("accesses").size(), 3);
+  BOOST_CHECK_EQUAL(root.object("accesses").vector(2).object("users").size(), 2);
+  BOOST_CHECK_EQUAL(root.object("other").object("a").num(), 1);
+  BOOST_CHECK(root.object("other").object("b").boolean());
+  
+  BOOST_CHECK_EQUAL(root.object("accesses").object("aaaaa").string(), "Path: /accesses Err: Dict is not an object");
+  BOOST_CHECK_EQUAL(root.object("accesses").vector(3).object("bbbbb").string(), "Path: /accesses Err: index 3 is invalid");
+  BOOST_CHECK_EQUAL(root.object("accesses").vector(2).object("bbbbb").string(), "Path: /accesses/2 Err: bbbbb not found");
+  BOOST_CHECK_EQUAL(root.object("other").object("a").string(), "Err: not a string");
+  
+}
+
+BOOST_AUTO_TEST_CASE( badJSON )
+{
+  cout << "=== badJSON ===" << endl;
+  
+  BOOST_CHECK(!Dict::parseTape(""));
+  BOOST_CHECK(!Dict::parseTape("{"));
+  BOOST_CHECK(!Dict::parseTape("{ \"a\": }"));
+  BOOST_CHECK(!Dict::parseTape("[1, 2,]"));
+  BOOST_CHECK(!Dict::parseTape("\"abc"));
+  BOOST_CHECK(!Dict::parseTape("01"));
+  BOOST_CHECK(!Dict::parseTape("[1] x"));
+  BOOST_CHECK(!Dict::parseTape("\"\\ud800\""));
+  BOOST_CHECK(Dict::parseTape(" [ ] "));
+  
+}
+
+BOOST_AUTO_TEST_CASE( iterate )
+{
+  cout << "=== iterate ===" << endl;
+  
+  auto tape = Dict::parseTape(complexJSON);
+  BOOST_CHECK(tape);
+  
+  vector<string> names;
+  for (auto e: tape->root().object("accesses")) {
+    names.push_back(e.object("name").string());
+  }
+  BOOST_CHECK_EQUAL(names.size(), 3);
+  BOOST_CHECK_EQUAL(names[2], "exec");
+  
+  auto other = tape->root().object("other");
+  string keys;
+  for (auto i = other.begin(); i != other.end(); ++i) {
+    keys += i.key();
+  }
+  BOOST_CHECK_EQUAL(keys, "abcde");
+  
+  auto a = other.object("a");
+  BOOST_CHECK(a.begin() == a.end());
+  
+}
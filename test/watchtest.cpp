@@ -0,0 +1,149 @@
+/*
+  watchtest.cpp
+  
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 18-Oct-2026
+  
+  Licensed under [version 3 of the GNU General Public License] contained in LICENSE.
+ 
+  https://github.com/visualopsholdings/dict
+*/
+
+
+#include "dictwatcher.hpp"
+
+#include <iostream>
+#include <fstream>
+
+#define BOOST_AUTO_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace vops;
+namespace fs = std::filesystem;
+
+void write(const fs::path &fn, const string &json) {
+  ofstream f(fn);
+  f << json;
+}
+
+// wait for the watcher to get past a version.
+bool waitFor(const DictWatcher &w, int version, int tries=100) {
+  for (int i=0; i<tries; i++) {
+    if (w.version() > version) {
+      return true;
+    }
+    this_thread::sleep_for(50ms);
+  }
+  return false;
+}
+
+long long port(shared_ptr<const DictG> g) {
+  return *Dict::getNum(*Dict::find_pointer(*g, "/web/port"));
+}
+
+BOOST_AUTO_TEST_CASE( watchEdits )
+{
+  cout << "=== watchEdits ===" << endl;
+ 
+  auto dir = fs::temp_directory_path() / "watchtest-edits";
+  fs::create_directories(dir);
+  write(dir / "root.json", "{ \"web\": { \"...\": \"<web.json>\" } }");
+  write(dir / "web.json", "{ \"port\": 80 }");
+  
+  atomic<int> called = 0;
+  DictWatcher w((dir / "root.json").string(), [&called](auto) { called++; });
+  auto g = w.get();
+  BOOST_CHECK(g);
+  BOOST_CHECK_EQUAL(port(g), 80);
+  
+  // change an included file.
+  auto v = w.version();
+  write(dir / "web.json", "{ \"port\": 8080 }");
+  BOOST_CHECK(waitFor(w, v));
+  BOOST_CHECK_EQUAL(port(w.get()), 8080);
+  for (int i=0; i<100 && !called; i++) {
+    this_thread::sleep_for(10ms);
+  }
+  BOOST_CHECK_EQUAL(called, 1);
+  
+  // the old version is still good.
+  BOOST_CHECK_EQUAL(port(g), 80);
+  
+  // a change that doesn't parse keeps the last one.
+  v = w.version();
+  write(dir / "web.json", "{ \"port\": ");
+  BOOST_CHECK(!waitFor(w, v, 10));
+  BOOST_CHECK_EQUAL(port(w.get()), 8080);
+  
+  // written to another file and renamed over it.
+  write(dir / "web.tmp", "{ \"port\": 8081 }");
+  fs::rename(dir / "web.tmp", dir / "web.json");
+  BOOST_CHECK(waitFor(w, v));
+  BOOST_CHECK_EQUAL(port(w.get()), 8081);
+  
+  fs::remove_all(dir);
+  
+}
+
+BOOST_AUTO_TEST_CASE( watchNewInclude )
+{
+  cout << "=== watchNewInclude ===" << endl;
+ 
+  auto dir = fs::temp_directory_path() / "watchtest-new";
+  fs::create_directories(dir / "sub");
+  write(dir / "root.json", "{ \"web\": { \"port\": 80 } }");
+  write(dir / "sub" / "web.json", "{ \"port\": 8080 }");
+  
+  DictWatcher w((dir / "root.json").string());
+  BOOST_CHECK_EQUAL(port(w.get()), 80);
+  
+  // start including a file in another directory, and then change that.
+  auto v = w.version();
+  write(dir / "root.json", "{ \"web\": { \"...\": \"<sub/web.json>\" } }");
+  BOOST_CHECK(waitFor(w, v));
+  BOOST_CHECK_EQUAL(port(w.get()), 8080);
+  
+  v = w.version();
+  write(dir / "sub" / "web.json", "{ \"port\": 8081 }");
+  BOOST_CHECK(waitFor(w, v));
+  BOOST_CHECK_EQUAL(port(w.get()), 8081);
+  
+  fs::remove_all(dir);
+  
+}
+
+BOOST_AUTO_TEST_CASE( watchMissingInclude )
+{
+  cout << "=== watchMissingInclude ===" << endl;
+ 
+  auto dir = fs::temp_directory_path() / "watchtest-missing";
+  fs::create_directories(dir);
+  write(dir / "root.json", "{ \"web\": { \"...\": \"<web.json>\", \"host\": \"localhost\" } }");
+  
+  DictWatcher w((dir / "root.json").string(), nullptr, true);
+  BOOST_CHECK(w.get());
+  BOOST_CHECK(!Dict::find_pointer(*w.get(), "/web/port"));
+  
+  // the include turns up.
+  auto v = w.version();
+  write(dir / "web.json", "{ \"port\": 8080 }");
+  BOOST_CHECK(waitFor(w, v));
+  BOOST_CHECK_EQUAL(port(w.get()), 8080);
+  BOOST_CHECK_EQUAL(Dict::getString(*Dict::find_pointer(*w.get(), "/web/host")).value_or(""), "localhost");
+  
+  // and still changes after that.
+  v = w.version();
+  write(dir / "web.json", "{ \"port\": 8081 }");
+  BOOST_CHECK(waitFor(w, v));
+  BOOST_CHECK_EQUAL(port(w.get()), 8081);
+  
+  // and goes away again.
+  v = w.version();
+  fs::remove(dir / "web.json");
+  BOOST_CHECK(waitFor(w, v));
+  BOOST_CHECK(!Dict::find_pointer(*w.get(), "/web/port"));
+  
+  fs::remove_all(dir);
+  
+}